@@ -3,6 +3,7 @@
 #include <expected>
 #include <functional>
 #include <map>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -76,6 +77,10 @@ namespace JsonTypedefCodeGen {
 
   template <typename Type> using JsonMap = std::map<std::string, Type>;
 
+  // JSON keys of the struct fields to deserialize. The other fields are
+  // skipped without being read, and keep their default value
+  using FieldProjection = std::span<const std::string_view>;
+
   // Expected Utils
   template <typename ResType>
   constexpr ExpType<ResType> flatten_expected(ResType&& value) {
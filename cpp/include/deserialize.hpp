@@ -2,9 +2,14 @@
 
 #ifdef IMPL_DESERIALIZE
 
+#include "direct_reader.hpp"
 #include "json_data.hpp"
 #include "json_reader.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <span>
 
@@ -14,6 +19,7 @@ namespace JsonTypedefCodeGen::Deserialize {
 
   namespace JDt = JsonTypedefCodeGen::Data;
   namespace JRd = JsonTypedefCodeGen::Reader;
+  namespace JDr = JsonTypedefCodeGen::Reader::Direct;
   using strview = std::string_view;
 
   namespace Errors {
@@ -22,6 +28,23 @@ namespace JsonTypedefCodeGen::Deserialize {
 
     UnexpJsonError not_string(const strview name);
 
+    UnexpJsonError disc_not_string(const strview disc);
+
+    UnexpJsonError invalid_value(const strview val, const strview name);
+
+    UnexpJsonError invalid_key(const strview key, const strview name);
+
+    UnexpJsonError missing_key(const strview entry, const strview name);
+
+    UnexpJsonError signed_limits(const int64_t value, const int64_t min,
+                                 const int64_t max);
+
+    UnexpJsonError unsigned_limits(const uint64_t value, const uint64_t max);
+
+    UnexpJsonError float_limits(const double value);
+
+    UnexpJsonError float_zeroes_limits(const double value);
+
   } // namespace Errors
 
   template <typename Type> struct Json;
@@ -42,6 +65,13 @@ namespace JsonTypedefCodeGen::Deserialize {
     });
   }
 
+  template <typename Type, JDr::Value JValue>
+  ExpType<void> deserialize_and_set(Type& dst, const JValue& value) {
+    return Json<Type>::deserialize(value).transform([&dst](auto v) {
+      dst = std::move(v);
+    });
+  }
+
   template <typename Type>
   constexpr ExpType<Type> optional_to_exp_type(const std::optional<Type>& opt,
                                                const JsonErrorTypes errtype,
@@ -56,12 +86,25 @@ namespace JsonTypedefCodeGen::Deserialize {
                                    const std::span<const strview> entries,
                                    const strview name);
 
-  template <typename JValue>
-  ExpType<int> get_enum_index(const JValue& value,
-                              const std::span<const strview> entries,
+  // "find" is the generated Common<T>::find, returning -1 when not found
+  template <typename JValue, typename Find>
+    requires std::is_invocable_r_v<int, Find, const strview>
+  ExpType<int> get_enum_index(const JValue& value, Find&& find,
                               const strview name) {
-    if (const auto str = value.read_str(); str.has_value()) {
-      return get_enum_index_impl(str.value(), entries, name);
+    // Data::JsonValue::read_str is already a view
+    const auto str = [&value]() {
+      if constexpr (JDr::StrViewValue<JValue>) {
+        return value.read_str_view();
+      } else {
+        return value.read_str();
+      }
+    }();
+
+    if (str.has_value()) {
+      if (const int index = find(str.value()); index >= 0) [[likely]] {
+        return index;
+      }
+      return Errors::invalid_value(str.value(), name);
     } else {
       if constexpr (std::is_same_v<JValue, JDt::JsonValue>) {
         return Errors::not_string(name);
@@ -71,25 +114,71 @@ namespace JsonTypedefCodeGen::Deserialize {
     }
   }
 
+  template <typename JValue>
+  ExpType<int> get_enum_index(const JValue& value,
+                              const std::span<const strview> entries,
+                              const strview name) {
+    return get_enum_index(
+        value,
+        [entries](const strview str) {
+          for (int index = 0; const auto entry : entries) {
+            if (str == entry) {
+              return index;
+            }
+            ++index;
+          }
+          return -1;
+        },
+        name);
+  }
+
   template <typename JValue, typename Cb>
-  constexpr ExpType<void> json_object_for_each(const JValue& value, Cb cb) {
+  constexpr ExpType<void> json_object_for_each(const JValue& value, Cb&& cb) {
     if constexpr (std::is_same_v<JValue, JRd::JsonValue> ||
                   std::is_same_v<JValue, JRd::JsonObject>) {
-      return JRd::json_object_for_each(value, cb);
+      return JRd::json_object_for_each(value, std::forward<Cb>(cb));
+    } else if constexpr (JDr::Value<JValue> || JDr::Object<JValue>) {
+      return JDr::json_object_for_each(value, std::forward<Cb>(cb));
     } else {
       // std::is_same_v<JValue, JDt::JsonValue>
-      return JDt::json_object_for_each(value, cb);
+      return JDt::json_object_for_each(value, std::forward<Cb>(cb));
     }
   }
 
   template <typename JValue, typename Cb>
-  constexpr ExpType<void> json_array_for_each(const JValue& value, Cb cb) {
+  constexpr ExpType<void> json_array_for_each(const JValue& value, Cb&& cb) {
     if constexpr (std::is_same_v<JValue, JRd::JsonValue> ||
                   std::is_same_v<JValue, JRd::JsonArray>) {
-      return JRd::json_array_for_each(value, cb);
+      return JRd::json_array_for_each(value, std::forward<Cb>(cb));
+    } else if constexpr (JDr::Value<JValue> || JDr::Array<JValue>) {
+      return JDr::json_array_for_each(value, std::forward<Cb>(cb));
     } else {
       // std::is_same_v<JValue, JDt::JsonValue>
-      return JDt::json_array_for_each(value, cb);
+      return JDt::json_array_for_each(value, std::forward<Cb>(cb));
+    }
+  }
+
+  // the array itself, to size containers before reading its items
+  template <typename JValue> auto read_json_array(const JValue& value) {
+    if constexpr (std::is_same_v<JValue, JDt::JsonValue>) {
+      if (auto opt_arr = value.read_array(); opt_arr.has_value()) {
+        return ExpType<JDt::JsonArray>(std::move(opt_arr.value()));
+      }
+      return ExpType<JDt::JsonArray>(make_json_error(
+          JsonErrorTypes::Invalid, std::string_view("expected an array")));
+    } else {
+      return value.read_array();
+    }
+  }
+
+  template <typename JArray>
+  std::size_t array_size_hint(const JArray& array) {
+    if constexpr (std::is_same_v<JArray, JDt::JsonArray>) {
+      return array.size();
+    } else if constexpr (JDr::SizeHint<JArray>) {
+      return array.size_hint();
+    } else {
+      return 0;
     }
   }
 
@@ -99,52 +188,262 @@ namespace JsonTypedefCodeGen::Deserialize {
                                   const std::span<const strview> entries,
                                   const strview name);
 
-  ExpType<std::string> get_disc_value(const JDt::JsonObject& object,
-                                      const strview disc, const strview name);
+  // one bit per entry of a struct or a variant, a single word up to 64 entries
+  template <size_t Size> class FieldMask {
+  private:
+    static constexpr size_t WordCount = (Size + 63) / 64;
+    std::array<uint64_t, WordCount> m_words{};
+
+  public:
+    constexpr FieldMask() = default;
+    constexpr FieldMask(const std::span<const int> indices) {
+      for (const auto idx : indices) {
+        set(idx);
+      }
+    }
+
+    constexpr bool test(const size_t idx) const {
+      return (m_words[idx / 64] >> (idx % 64)) & 1;
+    }
+    constexpr void set(const size_t idx) {
+      m_words[idx / 64] |= uint64_t(1) << (idx % 64);
+    }
+
+    // all the bits of "other" are also set here
+    constexpr bool contains(const FieldMask& other) const {
+      for (size_t w = 0; w < WordCount; ++w) {
+        if ((m_words[w] & other.m_words[w]) != other.m_words[w]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    constexpr FieldMask operator&(const FieldMask& other) const {
+      FieldMask result;
+      for (size_t w = 0; w < WordCount; ++w) {
+        result.m_words[w] = m_words[w] & other.m_words[w];
+      }
+      return result;
+    }
+  };
+
+  // the fields read without a projection, all of them
+  struct AllFields {
+    static constexpr bool test(const size_t) { return true; }
+  };
+
+  // the mandatory fields among those read
+  template <size_t Size>
+  constexpr const FieldMask<Size>& wanted_mandatory(
+      const FieldMask<Size>& mandatory, const AllFields) {
+    return mandatory;
+  }
+
+  template <size_t Size>
+  constexpr FieldMask<Size> wanted_mandatory(const FieldMask<Size>& mandatory,
+                                             const FieldMask<Size>& wanted) {
+    return mandatory & wanted;
+  }
+
+  // the entries of a projection's keys, "find" comes from Common<T>
+  template <typename Mask, typename Find>
+    requires std::is_invocable_r_v<int, Find, const strview>
+  ExpType<Mask> project_fields(const FieldProjection keys, Find&& find,
+                               const strview name) {
+    Mask wanted;
+    for (const auto key : keys) {
+      const int idx = find(key);
+      if (idx < 0) [[unlikely]] {
+        return Errors::invalid_key(key, name);
+      }
+      wanted.set(idx);
+    }
+    return wanted;
+  }
+
+  template <size_t Size>
+  ExpType<void> check_mandatory(const FieldMask<Size>& visited,
+                                const FieldMask<Size>& mandatory,
+                                const std::span<const strview> entries,
+                                const strview name) {
+    if (visited.contains(mandatory)) [[likely]] {
+      return ExpType<void>();
+    }
+    // only format the error for the first missing entry
+    size_t midx = 0;
+    while (visited.test(midx) || !mandatory.test(midx)) {
+      ++midx;
+    }
+    return Errors::missing_key(entries[midx], name);
+  }
+
+  // the view points inside the object
+  ExpType<strview> get_disc_value(const JDt::JsonObject& object,
+                                  const strview disc, const strview name);
+
+  // read on the reader's object, which can then be iterated for the variant.
+  // Same errors as above whatever the reader
+  template <typename JObject>
+    requires std::is_same_v<JObject, JRd::JsonObject> ||
+             JDr::StrFieldObject<JObject>
+  ExpType<strview> get_disc_value(const JObject& object, const strview disc,
+                                  const strview name) {
+    auto field = object.read_str_field(disc);
+    if (!field.has_value()) [[unlikely]] {
+      if (field.error().type == JsonErrorTypes::WrongType) {
+        return Errors::disc_not_string(disc);
+      }
+      return UnexpJsonError(std::move(field.error()));
+    }
+    if (!field.value().has_value()) [[unlikely]] {
+      return Errors::missing_key(disc, name);
+    }
+    return *field.value();
+  }
 
   ExpType<int> get_value_index(const strview value,
                                const std::span<const strview> entries,
                                const strview name);
 
+  // "index" comes from the generated Common<T>::find
+  inline ExpType<int> get_value_index(const int index, const strview value,
+                                      const strview name) {
+    if (index >= 0) [[likely]] {
+      return index;
+    }
+    return Errors::invalid_key(value, name);
+  }
+
+  // keys are usually written in the schema's order, so the entry after
+  // "last" is compared before calling "find". "last" is updated on a match
+  template <typename Find>
+    requires std::is_invocable_r_v<int, Find, const strview>
+  constexpr int find_next_index(const strview key, int& last,
+                                const std::span<const strview> entries,
+                                Find&& find) {
+    if (const auto next = size_t(last + 1);
+        next < entries.size() && entries[next] == key) [[likely]] {
+      return last = int(next);
+    }
+    if (const int index = find(key); index >= 0) {
+      return last = index;
+    }
+    return -1;
+  }
+
+  //  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  template <typename NumT>
+  ExpType<NumT> test_numerical_limits(const ExpType<int64_t> value) {
+    constexpr int64_t _min = std::numeric_limits<NumT>::min(),
+                      _max = std::numeric_limits<NumT>::max();
+    if (value.has_value()) [[likely]] {
+      const auto val = value.value();
+      if (val < _min || val > _max) [[unlikely]] {
+        return Errors::signed_limits(val, _min, _max);
+      }
+      return ExpType<NumT>((NumT)val);
+    }
+    return UnexpJsonError(std::move(value.error()));
+  }
+
+  template <typename NumT>
+  ExpType<NumT> test_numerical_limits(const ExpType<uint64_t> value) {
+    constexpr uint64_t _max = std::numeric_limits<NumT>::max();
+    if (value.has_value()) [[likely]] {
+      const auto val = value.value();
+      if (val > _max) [[unlikely]] {
+        return Errors::unsigned_limits(val, _max);
+      }
+      return ExpType<NumT>((NumT)val);
+    }
+    return UnexpJsonError(std::move(value.error()));
+  }
+
+  inline ExpType<float> test_numerical_limits(const ExpType<double> value) {
+    constexpr double _min = std::numeric_limits<float>::lowest(),
+                     _max = std::numeric_limits<float>::max(),
+                     _eps = std::numeric_limits<float>::min();
+    if (value.has_value()) [[likely]] {
+      const auto val = value.value();
+      if (val < _min || val > _max) [[unlikely]] {
+        return Errors::float_limits(val);
+      } else if (std::fabs(val) < _eps) [[unlikely]] {
+        return Errors::float_zeroes_limits(val);
+      }
+      return ExpType<float>((float)val);
+    }
+    return UnexpJsonError(std::move(value.error()));
+  }
+
   //  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
 
-  // more primitives
+  // more primitives, the compile-time readers (JDr::Value) are inlined
 
   template <> struct Json<bool> {
     static inline ExpType<bool> deserialize(const JRd::JsonValue& value) {
       return value.read_bool();
     }
     static ExpType<bool> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<bool> deserialize(const JValue& value) {
+      return value.read_bool();
+    }
   };
 
   template <> struct Json<int8_t> {
     static ExpType<int8_t> deserialize(const JRd::JsonValue& value);
     static ExpType<int8_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<int8_t> deserialize(const JValue& value) {
+      return test_numerical_limits<int8_t>(value.read_i64());
+    }
   };
 
   template <> struct Json<uint8_t> {
     static ExpType<uint8_t> deserialize(const JRd::JsonValue& value);
     static ExpType<uint8_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<uint8_t> deserialize(const JValue& value) {
+      return test_numerical_limits<uint8_t>(value.read_u64());
+    }
   };
 
   template <> struct Json<int16_t> {
     static ExpType<int16_t> deserialize(const JRd::JsonValue& value);
     static ExpType<int16_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<int16_t> deserialize(const JValue& value) {
+      return test_numerical_limits<int16_t>(value.read_i64());
+    }
   };
 
   template <> struct Json<uint16_t> {
     static ExpType<uint16_t> deserialize(const JRd::JsonValue& value);
     static ExpType<uint16_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<uint16_t> deserialize(const JValue& value) {
+      return test_numerical_limits<uint16_t>(value.read_u64());
+    }
   };
 
   template <> struct Json<int32_t> {
     static ExpType<int32_t> deserialize(const JRd::JsonValue& value);
     static ExpType<int32_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<int32_t> deserialize(const JValue& value) {
+      return test_numerical_limits<int32_t>(value.read_i64());
+    }
   };
 
   template <> struct Json<uint32_t> {
     static ExpType<uint32_t> deserialize(const JRd::JsonValue& value);
     static ExpType<uint32_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<uint32_t> deserialize(const JValue& value) {
+      return test_numerical_limits<uint32_t>(value.read_u64());
+    }
   };
 
   template <> struct Json<int64_t> {
@@ -152,6 +451,10 @@ namespace JsonTypedefCodeGen::Deserialize {
       return value.read_i64();
     }
     static ExpType<int64_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<int64_t> deserialize(const JValue& value) {
+      return value.read_i64();
+    }
   };
 
   template <> struct Json<uint64_t> {
@@ -159,11 +462,19 @@ namespace JsonTypedefCodeGen::Deserialize {
       return value.read_u64();
     }
     static ExpType<uint64_t> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<uint64_t> deserialize(const JValue& value) {
+      return value.read_u64();
+    }
   };
 
   template <> struct Json<float> {
     static ExpType<float> deserialize(const JRd::JsonValue& value);
     static ExpType<float> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<float> deserialize(const JValue& value) {
+      return test_numerical_limits(value.read_double());
+    }
   };
 
   template <> struct Json<double> {
@@ -171,6 +482,10 @@ namespace JsonTypedefCodeGen::Deserialize {
       return value.read_double();
     }
     static ExpType<double> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<double> deserialize(const JValue& value) {
+      return value.read_double();
+    }
   };
 
   template <> struct Json<std::string> {
@@ -179,6 +494,10 @@ namespace JsonTypedefCodeGen::Deserialize {
       return value.read_str();
     }
     static ExpType<std::string> deserialize(const JDt::JsonValue& value);
+    template <JDr::Value JValue>
+    static inline ExpType<std::string> deserialize(const JValue& value) {
+      return value.read_str();
+    }
   };
 
   template <> struct Json<Data::JsonValue> {
@@ -190,25 +509,145 @@ namespace JsonTypedefCodeGen::Deserialize {
     deserialize(const Data::JsonValue& v) {
       return std::move(v);
     }
+    template <JDr::Value JValue>
+    static inline ExpType<Data::JsonValue> deserialize(const JValue& v) {
+      return JDr::clone(v);
+    }
   };
 
+  // item by item, the vector reserved from the array's size hint
+  template <typename Type, typename JValue>
+  ExpType<std::vector<Type>> deserialize_items(const JValue& value) {
+    auto exp_arr = read_json_array(value);
+    if (!exp_arr.has_value()) [[unlikely]] {
+      return UnexpJsonError(std::move(exp_arr.error()));
+    }
+    const auto& array = exp_arr.value();
+
+    std::vector<Type> result;
+    result.reserve(array_size_hint(array));
+    auto feach =
+        json_array_for_each(array, [&](const auto& item) -> ExpType<void> {
+          if (auto exp_res = Json<Type>::deserialize(item);
+              exp_res.has_value()) {
+            result.emplace_back(std::move(exp_res.value()));
+            return ExpType<void>();
+          } else {
+            return UnexpJsonError(std::move(exp_res.error()));
+          }
+        });
+    if (!feach.has_value()) [[unlikely]] {
+      return UnexpJsonError(std::move(feach.error()));
+    }
+    return result;
+  }
+
   template <typename Type> struct Json<std::vector<Type>> {
     template <typename JValue>
     static ExpType<std::vector<Type>> deserialize(const JValue& value) {
-      std::vector<Type> result;
-      auto feach =
-          json_array_for_each(value, [&](const auto& item) -> ExpType<void> {
-            if (auto exp_res = Json<Type>::deserialize(item);
-                exp_res.has_value()) {
-              result.emplace_back(std::move(exp_res.value()));
-              return ExpType<void>();
+      return deserialize_items<Type>(value);
+    }
+  };
+
+  // numbers read in bulk from the reader's array into their widest type,
+  // then range checked and narrowed in one pass
+  template <typename NumT>
+  concept BulkNumber =
+      std::is_arithmetic_v<NumT> && !std::is_same_v<NumT, bool>;
+
+  template <BulkNumber NumT>
+  using WideNumber = std::conditional_t<
+      std::is_floating_point_v<NumT>, double,
+      std::conditional_t<std::is_signed_v<NumT>, int64_t, uint64_t>>;
+
+  // the same limits as test_numerical_limits, without the formatting
+  template <BulkNumber NumT>
+  constexpr bool out_of_limits(const WideNumber<NumT> val) {
+    if constexpr (std::is_same_v<NumT, float>) {
+      constexpr double _min = std::numeric_limits<float>::lowest(),
+                       _max = std::numeric_limits<float>::max(),
+                       _eps = std::numeric_limits<float>::min();
+      return (val < _min) | (val > _max) | (std::fabs(val) < _eps);
+    } else if constexpr (std::is_same_v<NumT, WideNumber<NumT>>) {
+      return false;
+    } else if constexpr (std::is_signed_v<NumT>) {
+      return (val < std::numeric_limits<NumT>::min()) |
+             (val > std::numeric_limits<NumT>::max());
+    } else {
+      return val > std::numeric_limits<NumT>::max();
+    }
+  }
+
+  // "wide" holds the numbers read before an eventual reading error, which
+  // only comes after their own limit errors
+  template <BulkNumber NumT>
+  ExpType<std::vector<NumT>>
+  narrow_numbers(std::vector<WideNumber<NumT>>&& wide, ExpType<void>&& read) {
+    if constexpr (std::is_same_v<NumT, WideNumber<NumT>>) {
+      if (!read.has_value()) {
+        return UnexpJsonError(std::move(read.error()));
+      }
+      return std::move(wide);
+    } else {
+      // no early exit, so the loop can be vectorized
+      bool bad = false;
+      for (const auto val : wide) {
+        bad |= out_of_limits<NumT>(val);
+      }
+      if (bad) [[unlikely]] {
+        for (const auto val : wide) {
+          if (out_of_limits<NumT>(val)) {
+            if constexpr (std::is_same_v<NumT, float>) {
+              return UnexpJsonError(
+                  test_numerical_limits(ExpType<double>(val)).error());
             } else {
-              return UnexpJsonError(std::move(exp_res.error()));
+              return UnexpJsonError(
+                  test_numerical_limits<NumT>(ExpType<WideNumber<NumT>>(val))
+                      .error());
             }
-          });
-      return feach.transform([res = std::move(result)]() {
-        return res;
-      });
+          }
+        }
+      }
+      if (!read.has_value()) {
+        return UnexpJsonError(std::move(read.error()));
+      }
+
+      std::vector<NumT> result(wide.size());
+      std::transform(wide.begin(), wide.end(), result.begin(),
+                     [](const auto val) { return static_cast<NumT>(val); });
+      return result;
+    }
+  }
+
+  template <BulkNumber Type> struct Json<std::vector<Type>> {
+    using Wide = WideNumber<Type>;
+
+    static ExpType<std::vector<Type>>
+    deserialize(const JRd::JsonValue& value) {
+      auto exp_arr = value.read_array();
+      if (!exp_arr.has_value()) [[unlikely]] {
+        return UnexpJsonError(std::move(exp_arr.error()));
+      }
+      std::vector<Wide> wide;
+      auto read = exp_arr.value().read_numbers_into(wide);
+      return narrow_numbers<Type>(std::move(wide), std::move(read));
+    }
+
+    template <typename JValue>
+    static ExpType<std::vector<Type>> deserialize(const JValue& value) {
+      if constexpr (JDr::Value<JValue>) {
+        if constexpr (JDr::NumberArray<typename JValue::Array>) {
+          auto exp_arr = value.read_array();
+          if (!exp_arr.has_value()) [[unlikely]] {
+            return UnexpJsonError(std::move(exp_arr.error()));
+          }
+          std::vector<Wide> wide;
+          auto read = exp_arr.value().read_numbers_into(wide);
+          return narrow_numbers<Type>(std::move(wide), std::move(read));
+        }
+      }
+      // item by item, like any other vector
+      return deserialize_items<Type>(value);
     }
   };
 
@@ -231,9 +670,10 @@ namespace JsonTypedefCodeGen::Deserialize {
               return UnexpJsonError(std::move(exp_res.error()));
             }
           });
-      return feach.transform([res = std::move(result)]() {
-        return res;
-      });
+      if (!feach.has_value()) [[unlikely]] {
+        return UnexpJsonError(std::move(feach.error()));
+      }
+      return result;
     }
   };
 
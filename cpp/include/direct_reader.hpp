@@ -0,0 +1,241 @@
+#pragma once
+
+#include "json_data.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Compile-time reader interface
+// The concrete value types of each wrapped library ("simd.hpp",
+// "nlohmann.hpp", "napi.hpp") are used as is: no heap allocated pimpl, no RTTI
+// and no virtual calls. They only live as long as the parsed document, and
+// aren't ABI stable, use "json_reader.hpp" for that.
+
+namespace JsonTypedefCodeGen::Reader::Direct {
+
+  template <typename JValue>
+  concept Value = requires(const JValue& value) {
+    typename JValue::Array;
+    typename JValue::Object;
+
+    { value.get_type() } -> std::same_as<JsonTypes>;
+    { value.get_number_type() } -> std::same_as<NumberType>;
+
+    { value.is_null() } -> std::same_as<ExpType<bool>>;
+    { value.read_bool() } -> std::same_as<ExpType<bool>>;
+    { value.read_double() } -> std::same_as<ExpType<double>>;
+    { value.read_u64() } -> std::same_as<ExpType<uint64_t>>;
+    { value.read_i64() } -> std::same_as<ExpType<int64_t>>;
+    { value.read_str() } -> std::same_as<ExpType<std::string>>;
+    { value.read_array() } -> std::same_as<ExpType<typename JValue::Array>>;
+    { value.read_object() } -> std::same_as<ExpType<typename JValue::Object>>;
+  };
+
+  // values reading strings without a copy, the view stays valid as long as
+  // the value and its document
+  template <typename JValue>
+  concept StrViewValue = requires(const JValue& value) {
+    { value.read_str_view() } -> std::same_as<ExpType<std::string_view>>;
+  };
+
+  // iterators yield ExpType<Value>, and ExpType<std::pair<Key, Value>> for
+  // objects, they end on std::default_sentinel_t
+  template <typename JArray>
+  concept Array = requires(const JArray& array) {
+    typename JArray::Value;
+
+    { array.begin() == array.end() } -> std::convertible_to<bool>;
+    { *array.begin() } -> std::same_as<ExpType<typename JArray::Value>>;
+  };
+
+  template <typename JObject>
+  concept Object = requires(const JObject& object) {
+    typename JObject::Value;
+
+    { object.begin() == object.end() } -> std::convertible_to<bool>;
+    { (*object.begin()).value().first } -> std::convertible_to<std::string_view>;
+    {
+      (*object.begin()).value().second
+    } -> std::convertible_to<typename JObject::Value>;
+  };
+
+  // objects reading a string field by key, like a discriminator's tag. They
+  // can still be iterated from the start afterwards. An absent key is
+  // nullopt, a value that's not a string is a WrongType error
+  template <typename JObject>
+  concept StrFieldObject =
+      Object<JObject> && requires(const JObject& object, std::string_view key) {
+        {
+          object.read_str_field(key)
+        } -> std::same_as<ExpType<std::optional<std::string_view>>>;
+      };
+
+  // arrays reading all their items as numbers in one go. On error, the
+  // numbers read before the failing item are kept
+  template <typename JArray>
+  concept NumberArray =
+      Array<JArray> && requires(const JArray& array, std::vector<double>& dbl,
+                                std::vector<int64_t>& i64,
+                                std::vector<uint64_t>& u64) {
+        { array.read_numbers_into(dbl) } -> std::same_as<ExpType<void>>;
+        { array.read_numbers_into(i64) } -> std::same_as<ExpType<void>>;
+        { array.read_numbers_into(u64) } -> std::same_as<ExpType<void>>;
+      };
+
+  // arrays and objects telling their number of items before being read, 0
+  // when unknown. Only used to reserve containers
+  template <typename JContainer>
+  concept SizeHint = requires(const JContainer& container) {
+    { container.size_hint() } -> std::same_as<std::size_t>;
+  };
+
+  // Iterator Utils, stop at the first error
+  template <Array JArray, typename Cb>
+  ExpType<void> json_array_for_each(const JArray& array, Cb&& cb) {
+    for (auto item : array) {
+      if (!item.has_value()) [[unlikely]] {
+        return UnexpJsonError(std::move(item.error()));
+      }
+      if (auto exp = cb(item.value()); !exp.has_value()) {
+        return UnexpJsonError(std::move(exp.error()));
+      }
+    }
+    return ExpType<void>();
+  }
+
+  template <Value JValue, typename Cb>
+  ExpType<void> json_array_for_each(const JValue& value, Cb&& cb) {
+    if (auto array = value.read_array(); array.has_value()) [[likely]] {
+      return json_array_for_each(array.value(), std::forward<Cb>(cb));
+    } else {
+      return UnexpJsonError(std::move(array.error()));
+    }
+  }
+
+  template <Object JObject, typename Cb>
+  ExpType<void> json_object_for_each(const JObject& object, Cb&& cb) {
+    for (auto item : object) {
+      if (!item.has_value()) [[unlikely]] {
+        return UnexpJsonError(std::move(item.error()));
+      }
+
+      const auto& [key, val] = item.value();
+      if (auto exp = cb(std::string_view(key), val); !exp.has_value()) {
+        return UnexpJsonError(std::move(exp.error()));
+      }
+    }
+    return ExpType<void>();
+  }
+
+  template <Value JValue, typename Cb>
+  ExpType<void> json_object_for_each(const JValue& value, Cb&& cb) {
+    if (auto object = value.read_object(); object.has_value()) [[likely]] {
+      return json_object_for_each(object.value(), std::forward<Cb>(cb));
+    } else {
+      return UnexpJsonError(std::move(object.error()));
+    }
+  }
+
+  // Copy into the neutral representation
+  template <Value JValue> ExpType<Data::JsonValue> clone(const JValue& value);
+
+  template <Array JArray> ExpType<Data::JsonArray> clone(const JArray& array) {
+    Data::JsonArray _result;
+    auto& result = _result.internal();
+    if constexpr (SizeHint<JArray>) {
+      result.reserve(array.size_hint());
+    }
+    for (auto item : array) {
+      if (!item.has_value()) [[unlikely]] {
+        return UnexpJsonError(std::move(item.error()));
+      }
+
+      if (auto tmp = clone(item.value()); tmp.has_value()) [[likely]] {
+        result.emplace_back(std::move(tmp.value()));
+      } else {
+        return UnexpJsonError(std::move(tmp.error()));
+      }
+    }
+    return _result;
+  }
+
+  template <Object JObject>
+  ExpType<Data::JsonObject> clone(const JObject& object) {
+    Data::JsonObject _result;
+    auto& result = _result.internal();
+    for (auto item : object) {
+      if (!item.has_value()) [[unlikely]] {
+        return UnexpJsonError(std::move(item.error()));
+      }
+
+      const auto& [key, val] = item.value();
+      if (auto tmp = clone(val); tmp.has_value()) [[likely]] {
+        const auto [it, ok] =
+            result.emplace(std::string(key), std::move(tmp.value()));
+        if (!ok) {
+          const auto err = std::format("Duplicated key {}", std::string(key));
+          return make_json_error(JsonErrorTypes::String, err);
+        }
+      } else {
+        return UnexpJsonError(std::move(tmp.error()));
+      }
+    }
+    return _result;
+  }
+
+  template <Value JValue> ExpType<Data::JsonValue> clone(const JValue& value) {
+    constexpr auto conv = [](auto v) {
+      return Data::JsonValue(std::move(v));
+    };
+
+    switch (value.get_type()) {
+    case JsonTypes::Null:
+      return Data::JsonValue(nullptr);
+
+    case JsonTypes::Bool:
+      return value.read_bool().transform(conv);
+
+    case JsonTypes::Number:
+      switch (value.get_number_type()) {
+      case NumberType::Double:
+        return value.read_double().transform(conv);
+      case NumberType::I64:
+        return value.read_i64().transform(conv);
+      case NumberType::U64:
+        return value.read_u64().transform(conv);
+      case NumberType::NaN:
+      default:
+        return make_json_error(JsonErrorTypes::WrongType);
+      }
+
+    case JsonTypes::String:
+      return value.read_str().transform(conv);
+
+    case JsonTypes::Array:
+      if (auto tmp = value.read_array(); tmp.has_value()) {
+        return clone(tmp.value()).transform(conv);
+      } else {
+        return UnexpJsonError(std::move(tmp.error()));
+      }
+
+    case JsonTypes::Object:
+      if (auto tmp = value.read_object(); tmp.has_value()) {
+        return clone(tmp.value()).transform(conv);
+      } else {
+        return UnexpJsonError(std::move(tmp.error()));
+      }
+
+    default:
+      break;
+    }
+    return make_json_error(JsonErrorTypes::Invalid);
+  }
+
+} // namespace JsonTypedefCodeGen::Reader::Direct
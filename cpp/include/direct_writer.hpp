@@ -0,0 +1,44 @@
+#pragma once
+
+#include "json_data.hpp"
+#include "json_writer.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+
+// Compile-time writer interface
+// The generated serialization code is a template over the writer. A concrete
+// writer like StreamSerializer ("stream_serializer.hpp") is then called
+// directly: no pimpl and no virtual calls. The type-erased Serializer of
+// "json_writer.hpp" satisfies it too, for dynamic use.
+
+namespace JsonTypedefCodeGen::Writer::Direct {
+
+  template <typename JWriter>
+  concept Serializer =
+      requires(JWriter& writer, const std::string_view str, const KeyToken& key,
+               const Data::JsonArray& arr, const Data::JsonObject& obj,
+               const Data::JsonValue& val) {
+        { writer.write_null() } -> std::same_as<ExpType<void>>;
+        { writer.write_bool(true) } -> std::same_as<ExpType<void>>;
+        { writer.write_float(0.0f) } -> std::same_as<ExpType<void>>;
+        { writer.write_double(0.0) } -> std::same_as<ExpType<void>>;
+        { writer.write_i64(int64_t(0)) } -> std::same_as<ExpType<void>>;
+        { writer.write_u64(uint64_t(0)) } -> std::same_as<ExpType<void>>;
+        { writer.write_str(str) } -> std::same_as<ExpType<void>>;
+
+        { writer.start_object() } -> std::same_as<ExpType<void>>;
+        { writer.write_key(str) } -> std::same_as<ExpType<void>>;
+        { writer.write_key_token(key) } -> std::same_as<ExpType<void>>;
+        { writer.end_object() } -> std::same_as<ExpType<void>>;
+
+        { writer.start_array() } -> std::same_as<ExpType<void>>;
+        { writer.end_array() } -> std::same_as<ExpType<void>>;
+
+        { writer.write(arr) } -> std::same_as<ExpType<void>>;
+        { writer.write(obj) } -> std::same_as<ExpType<void>>;
+        { writer.write(val) } -> std::same_as<ExpType<void>>;
+      };
+
+} // namespace JsonTypedefCodeGen::Writer::Direct
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -158,4 +159,49 @@ namespace JsonTypedefCodeGen::Data {
     std::optional<JsonObject> read_object() const;
   };
 
+  // Iterator Utils, with inlined callbacks instead of std::function
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const JsonValue&>
+  ExpType<void> json_array_for_each(const JsonArray& array, Cb&& cb) {
+    for (const auto& item : array) {
+      if (auto exp = cb(item); !exp.has_value()) {
+        return UnexpJsonError(std::move(exp.error()));
+      }
+    }
+    return ExpType<void>();
+  }
+
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const JsonValue&>
+  ExpType<void> json_array_for_each(const JsonValue& value, Cb&& cb) {
+    if (auto opt_arr = value.read_array(); opt_arr.has_value()) {
+      return json_array_for_each(*opt_arr, cb);
+    }
+    return make_json_error(JsonErrorTypes::Invalid,
+                           std::string_view("expected an array"));
+  }
+
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const std::string_view,
+                                   const JsonValue&>
+  ExpType<void> json_object_for_each(const JsonObject& object, Cb&& cb) {
+    for (const auto& [key, val] : object) {
+      if (auto exp = cb(std::string_view(key), val); !exp.has_value()) {
+        return UnexpJsonError(std::move(exp.error()));
+      }
+    }
+    return ExpType<void>();
+  }
+
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const std::string_view,
+                                   const JsonValue&>
+  ExpType<void> json_object_for_each(const JsonValue& value, Cb&& cb) {
+    if (auto opt_obj = value.read_object(); opt_obj.has_value()) {
+      return json_object_for_each(*opt_obj, cb);
+    }
+    return make_json_error(JsonErrorTypes::Invalid,
+                           std::string_view("expected an object"));
+  }
+
 } // namespace JsonTypedefCodeGen::Data
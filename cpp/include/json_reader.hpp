@@ -1,11 +1,16 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "json_data.hpp"
 
@@ -17,22 +22,64 @@ namespace JsonTypedefCodeGen::Reader {
   class JsonObject;
   class JsonValue;
 
+  // memory pool for all the values, arrays, objects and iterators created
+  // while reading one document, released at once when destroyed.
+  // it must outlive all of them, and it isn't thread safe
+  class Session {
+  private:
+    static constexpr std::size_t initial_size = 4096;
+
+    alignas(std::max_align_t) std::array<std::byte, initial_size> m_buffer;
+    std::pmr::monotonic_buffer_resource m_arena;
+    std::pmr::unsynchronized_pool_resource m_pool;
+
+  public:
+    Session(std::pmr::memory_resource* upstream =
+                std::pmr::get_default_resource());
+    Session(const Session&) = delete;
+    Session(Session&&) = delete;
+    ~Session();
+
+    Session& operator=(const Session&) = delete;
+    Session& operator=(Session&&) = delete;
+
+    inline std::pmr::memory_resource* resource() { return &m_pool; }
+  };
+
   namespace Specialization {
 
+    // destroy a pimpl object, allocated on the heap or from a Session
+    struct PimplDeleter {
+      std::pmr::memory_resource* resource = nullptr;
+      std::uint32_t size = 0;
+      std::uint32_t align = 0;
+
+      template <typename Base> void operator()(Base* ptr) const {
+        if (resource == nullptr) {
+          delete ptr;
+        } else {
+          void* mem = dynamic_cast<void*>(ptr);
+          ptr->~Base();
+          resource->deallocate(mem, size, align);
+        }
+      }
+    };
+
     class BaseArrayIterator;
-    using ArrayIteratorPtr = std::unique_ptr<BaseArrayIterator>;
+    using ArrayIteratorPtr = std::unique_ptr<BaseArrayIterator, PimplDeleter>;
 
     class BaseObjectIterator;
-    using ObjectIteratorPtr = std::unique_ptr<BaseObjectIterator>;
+    using ObjectIteratorPtr =
+        std::unique_ptr<BaseObjectIterator, PimplDeleter>;
 
     class BaseArray;
-    using ArrayPtr = std::unique_ptr<BaseArray>;
+    using ArrayPtr = std::unique_ptr<BaseArray, PimplDeleter>;
 
     class BaseObject;
-    using ObjectPtr = std::unique_ptr<BaseObject>;
+    using ObjectPtr = std::unique_ptr<BaseObject, PimplDeleter>;
 
     class BaseValue;
-    using ValuePtr = std::unique_ptr<BaseValue>;
+    using ValuePtr = std::unique_ptr<BaseValue, PimplDeleter>;
 
     class BaseArrayIterator {
     protected:
@@ -77,6 +124,9 @@ namespace JsonTypedefCodeGen::Reader {
   } // namespace Specialization
 
   using ObjectIteratorPair = std::pair<std::string, JsonValue>;
+  // the key is valid until the iterator moves on, simdjson keeps it for the
+  // whole document
+  using ObjectIteratorViewPair = std::pair<std::string_view, JsonValue>;
 
   class JsonArrayIterator : public std::input_iterator_tag {
   private:
@@ -124,12 +174,47 @@ namespace JsonTypedefCodeGen::Reader {
     JsonObjectIterator& operator=(JsonObjectIterator&&) = default;
 
     value_type operator*() const;
+    ExpType<ObjectIteratorViewPair> view() const;
     JsonObjectIterator& operator++();
     inline void operator++(int) { ++(*this); }
 
     bool operator==(std::default_sentinel_t) const;
   };
 
+  // same as JsonObjectIterator, without copying the keys
+  class JsonObjectViewIterator : public std::input_iterator_tag {
+  private:
+    JsonObjectIterator m_iter;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<ObjectIteratorViewPair>;
+
+    JsonObjectViewIterator() = default;
+    JsonObjectViewIterator(JsonObjectIterator&& iter)
+        : m_iter(std::move(iter)) {}
+
+    value_type operator*() const;
+    JsonObjectViewIterator& operator++();
+    inline void operator++(int) { ++(*this); }
+
+    bool operator==(std::default_sentinel_t) const;
+  };
+
+  // range over an object, with the keys as views
+  class JsonObjectViews {
+  private:
+    const JsonObject& m_object;
+
+  public:
+    JsonObjectViews(const JsonObject& object) : m_object(object) {}
+
+    JsonObjectViewIterator begin() const;
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+  };
+
   class JsonArray {
   private:
     friend class Specialization::BaseArray;
@@ -151,6 +236,16 @@ namespace JsonTypedefCodeGen::Reader {
       return std::default_sentinel_t{};
     }
 
+    // number of items, to reserve containers before reading them. It's 0 when
+    // the library can't tell without walking the array
+    std::size_t size_hint() const;
+
+    // all the items as numbers, without a JsonValue per item. On error, the
+    // numbers read before the failing item are kept
+    ExpType<void> read_numbers_into(std::vector<double>& numbers) const;
+    ExpType<void> read_numbers_into(std::vector<int64_t>& numbers) const;
+    ExpType<void> read_numbers_into(std::vector<uint64_t>& numbers) const;
+
     ExpType<Data::JsonArray> clone() const;
   };
 
@@ -174,6 +269,16 @@ namespace JsonTypedefCodeGen::Reader {
     inline std::default_sentinel_t end() const {
       return std::default_sentinel_t{};
     }
+    inline JsonObjectViews views() const { return JsonObjectViews(*this); }
+
+    // number of fields, 0 when unknown. See JsonArray::size_hint
+    std::size_t size_hint() const;
+
+    // string value of a field, like a discriminator's tag. The object can
+    // still be iterated from the start afterwards. nullopt if the key is
+    // absent, a WrongType error if the value isn't a string
+    ExpType<std::optional<std::string_view>>
+    read_str_field(const std::string_view key) const;
 
     ExpType<Data::JsonObject> clone() const;
   };
@@ -202,6 +307,8 @@ namespace JsonTypedefCodeGen::Reader {
     ExpType<uint64_t> read_u64() const;
     ExpType<int64_t> read_i64() const;
     ExpType<std::string> read_str() const;
+    // no copy, the view stays valid as long as this value and its document
+    ExpType<std::string_view> read_str_view() const;
     ExpType<JsonArray> read_array() const;
     ExpType<JsonObject> read_object() const;
 
@@ -221,4 +328,56 @@ namespace JsonTypedefCodeGen::Reader {
   ExpType<void> json_object_for_each(const JsonValue& value,
                                      ObjectForEachFn cb);
 
+  // same, with inlined callbacks instead of std::function
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const JsonValue&>
+  ExpType<void> json_array_for_each(const JsonArray& array, Cb&& cb) {
+    for (const auto& item : array) {
+      if (!item.has_value()) [[unlikely]] {
+        return UnexpJsonError(item.error());
+      }
+      if (auto exp = cb(item.value()); !exp.has_value()) {
+        return UnexpJsonError(std::move(exp.error()));
+      }
+    }
+    return ExpType<void>();
+  }
+
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const JsonValue&>
+  ExpType<void> json_array_for_each(const JsonValue& value, Cb&& cb) {
+    if (const auto exp_arr = value.read_array(); exp_arr.has_value()) {
+      return json_array_for_each(exp_arr.value(), cb);
+    } else {
+      return UnexpJsonError(exp_arr.error());
+    }
+  }
+
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const std::string_view,
+                                   const JsonValue&>
+  ExpType<void> json_object_for_each(const JsonObject& object, Cb&& cb) {
+    for (const auto& item : object.views()) {
+      if (!item.has_value()) [[unlikely]] {
+        return UnexpJsonError(item.error());
+      }
+      const auto& [key, val] = item.value();
+      if (auto exp = cb(key, val); !exp.has_value()) {
+        return UnexpJsonError(std::move(exp.error()));
+      }
+    }
+    return ExpType<void>();
+  }
+
+  template <typename Cb>
+    requires std::is_invocable_r_v<ExpType<void>, Cb&, const std::string_view,
+                                   const JsonValue&>
+  ExpType<void> json_object_for_each(const JsonValue& value, Cb&& cb) {
+    if (const auto exp_obj = value.read_object(); exp_obj.has_value()) {
+      return json_object_for_each(exp_obj.value(), cb);
+    } else {
+      return UnexpJsonError(exp_obj.error());
+    }
+  }
+
 } // namespace JsonTypedefCodeGen::Reader
@@ -7,6 +7,13 @@
 
 namespace JsonTypedefCodeGen::Writer {
 
+  // a key known before serializing, like the generated struct fields. The
+  // token is its JSON text, escaped and followed by the colon: "\"key\":"
+  struct KeyToken {
+    std::string_view key;
+    std::string_view token;
+  };
+
   class Serializer;
 
   namespace Specialization {
@@ -44,6 +51,7 @@ namespace JsonTypedefCodeGen::Writer {
 
     ExpType<void> write_null();
     ExpType<void> write_bool(const bool b);
+    ExpType<void> write_float(const float f);
     ExpType<void> write_double(const double d);
     ExpType<void> write_i64(const int64_t i);
     ExpType<void> write_u64(const uint64_t u);
@@ -51,6 +59,7 @@ namespace JsonTypedefCodeGen::Writer {
 
     ExpType<void> start_object();
     ExpType<void> write_key(const std::string_view key);
+    ExpType<void> write_key_token(const KeyToken& key);
     ExpType<void> end_object();
 
     ExpType<void> start_array();
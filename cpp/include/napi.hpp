@@ -6,14 +6,383 @@
 
 #ifdef USE_IN_NAPI
 
+#include "direct_reader.hpp"
 #include "json_reader.hpp"
 
+#include <cmath>
+#include <limits>
+
 namespace JsonTypedefCodeGen::Reader {
 
   ExpType<JsonValue> napi_root_value(const Napi::Value root);
 
+  // same, but all the reader objects are allocated from the session pool
+  ExpType<JsonValue> napi_root_value(const Napi::Value root, Session& session);
+
 } // namespace JsonTypedefCodeGen::Reader
 
+namespace JsonTypedefCodeGen::Reader::Direct {
+
+  using namespace std::string_view_literals;
+
+  class NapiArray;
+  class NapiObject;
+
+  class NapiValue {
+  private:
+    Napi::Value m_value;
+
+  public:
+    using Array = NapiArray;
+    using Object = NapiObject;
+
+    NapiValue() = delete;
+    NapiValue(const Napi::Value val) : m_value(val) {}
+
+    JsonTypes get_type() const;
+
+    ExpType<bool> is_null() const;
+    ExpType<bool> read_bool() const;
+    ExpType<double> read_double() const;
+    ExpType<uint64_t> read_u64() const;
+    ExpType<int64_t> read_i64() const;
+    ExpType<std::string> read_str() const;
+    ExpType<NapiArray> read_array() const;
+    ExpType<NapiObject> read_object() const;
+
+    NumberType get_number_type() const;
+  };
+
+  class NapiArrayIterator {
+  private:
+    Napi::Array m_array;
+    uint32_t m_index = 0;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<NapiValue>;
+
+    NapiArrayIterator() = delete;
+    NapiArrayIterator(const Napi::Array arr) : m_array(arr) {}
+
+    value_type operator*() const;
+    NapiArrayIterator& operator++();
+    inline void operator++(int) { ++(*this); }
+
+    bool operator==(std::default_sentinel_t) const;
+  };
+
+  class NapiArray {
+  private:
+    Napi::Array m_array;
+
+  public:
+    using Value = NapiValue;
+
+    NapiArray() = delete;
+    NapiArray(const Napi::Array arr) : m_array(arr) {}
+
+    inline NapiArrayIterator begin() const {
+      return NapiArrayIterator(m_array);
+    }
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    inline std::size_t size_hint() const { return m_array.Length(); }
+
+    template <typename NumT>
+      requires std::is_same_v<NumT, double> || std::is_same_v<NumT, int64_t> ||
+               std::is_same_v<NumT, uint64_t>
+    ExpType<void> read_numbers_into(std::vector<NumT>& numbers) const;
+  };
+
+  using NapiObjectPair = std::pair<std::string, NapiValue>;
+
+  class NapiObjectIterator {
+  private:
+    Napi::Object m_object;
+    Napi::Array m_keys;
+    uint32_t m_index = 0;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<NapiObjectPair>;
+
+    NapiObjectIterator() = delete;
+    NapiObjectIterator(const Napi::Object object);
+
+    value_type operator*() const;
+    NapiObjectIterator& operator++();
+    inline void operator++(int) { ++(*this); }
+
+    bool operator==(std::default_sentinel_t) const;
+  };
+
+  class NapiObject {
+  private:
+    Napi::Object m_object;
+
+  public:
+    using Value = NapiValue;
+
+    NapiObject() = delete;
+    NapiObject(const Napi::Object obj) : m_object(obj) {}
+
+    inline NapiObjectIterator begin() const {
+      return NapiObjectIterator(m_object);
+    }
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    // listing the keys costs about as much as iterating them
+    inline std::size_t size_hint() const { return 0; }
+
+    bool has_field(const std::string_view key) const;
+    ExpType<NapiValue> read_field(const std::string_view key) const;
+  };
+
+  inline ExpType<NapiValue> napi_root_value(const Napi::Value root) {
+    if (root.IsArray() || root.IsObject()) {
+      return NapiValue(root);
+    }
+    return make_json_error(
+        JsonErrorTypes::Invalid,
+        "Expect root Napi::Value to be an object or an array"sv);
+  }
+
+  // -------------------------------------------
+  constexpr JsonTypes map_napi_type(const napi_valuetype type) {
+    switch (type) {
+    case napi_undefined:
+    case napi_null:
+      return JsonTypes::Null;
+    case napi_boolean:
+      return JsonTypes::Bool;
+    case napi_number:
+    case napi_bigint:
+      return JsonTypes::Number;
+    case napi_string:
+    case napi_symbol:
+      return JsonTypes::String;
+    case napi_object:
+      return JsonTypes::Object;
+    case napi_function:
+    case napi_external:
+    default:
+      return JsonTypes::Invalid;
+    }
+  }
+
+  inline JsonTypes NapiValue::get_type() const {
+    if (m_value.IsEmpty()) {
+      return JsonTypes::Invalid;
+    } else if (m_value.IsArray()) {
+      return JsonTypes::Array;
+    } else {
+      return map_napi_type(m_value.Type());
+    }
+  }
+
+  inline ExpType<bool> NapiValue::is_null() const {
+    return m_value.IsNull() || m_value.IsUndefined();
+  }
+
+  inline ExpType<bool> NapiValue::read_bool() const {
+    if (m_value.IsBoolean()) {
+      return m_value.ToBoolean();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a boolean"sv);
+  }
+
+  inline ExpType<double> NapiValue::read_double() const {
+    if (m_value.IsBigInt()) {
+      bool lossless = false;
+      return double(m_value.As<Napi::BigInt>().Int64Value(&lossless));
+    } else if (m_value.IsNumber()) {
+      return m_value.ToNumber().DoubleValue();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+  }
+
+  inline ExpType<uint64_t> NapiValue::read_u64() const {
+    if (m_value.IsBigInt()) {
+      bool lossless = false;
+      return m_value.As<Napi::BigInt>().Uint64Value(&lossless);
+    } else if (m_value.IsNumber()) {
+      return m_value.ToNumber().Uint32Value();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+  }
+
+  inline ExpType<int64_t> NapiValue::read_i64() const {
+    if (m_value.IsBigInt()) {
+      bool lossless = false;
+      return m_value.As<Napi::BigInt>().Int64Value(&lossless);
+    } else if (m_value.IsNumber()) {
+      return m_value.ToNumber().Int64Value();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+  }
+
+  inline ExpType<std::string> NapiValue::read_str() const {
+    if (m_value.IsString() || m_value.IsSymbol()) {
+      return m_value.ToString();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a string"sv);
+  }
+
+  inline ExpType<NapiArray> NapiValue::read_array() const {
+    if (m_value.IsArray()) {
+      return NapiArray(m_value.As<Napi::Array>());
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not an array"sv);
+  }
+
+  inline ExpType<NapiObject> NapiValue::read_object() const {
+    if (!m_value.IsObject()) {
+      return make_json_error(JsonErrorTypes::WrongType, "not an object"sv);
+    } else if (m_value.IsArray()) {
+      return make_json_error(JsonErrorTypes::WrongType,
+                             "the object is an array"sv);
+    } else {
+      return NapiObject(m_value.As<Napi::Object>());
+    }
+  }
+
+  inline NumberType NapiValue::get_number_type() const {
+    if (m_value.IsBigInt()) {
+      bool lossless = false;
+      if (m_value.As<Napi::BigInt>().Int64Value(&lossless); lossless) {
+        return NumberType::I64;
+      }
+
+      lossless = false;
+      if (m_value.As<Napi::BigInt>().Uint64Value(&lossless); lossless) {
+        return NumberType::U64;
+      }
+      return NumberType::Double;
+    } else if (m_value.IsNumber()) {
+      const auto dbl = m_value.ToNumber().DoubleValue();
+      double intpart = 0.0;
+      if (std::modf(dbl, &intpart) == 0.0) {
+        if (dbl < 0.0) {
+          if (dbl > double(std::numeric_limits<int64_t>::min())) {
+            return NumberType::I64;
+          }
+        } else if (dbl <= double(std::numeric_limits<uint64_t>::max())) {
+          return NumberType::U64;
+        }
+      }
+      return NumberType::Double;
+    }
+    return NumberType::NaN;
+  }
+
+  // -------------------------------------------
+  inline NapiArrayIterator::value_type NapiArrayIterator::operator*() const {
+    if (const auto val = m_array.Get(m_index); val.IsEmpty()) {
+      return make_json_error(JsonErrorTypes::Invalid, "Empty value"sv);
+    } else {
+      return NapiValue(val);
+    }
+  }
+
+  template <typename NumT>
+    requires std::is_same_v<NumT, double> || std::is_same_v<NumT, int64_t> ||
+             std::is_same_v<NumT, uint64_t>
+  ExpType<void> NapiArray::read_numbers_into(std::vector<NumT>& numbers) const {
+    const uint32_t size = m_array.Length();
+    numbers.reserve(numbers.size() + size);
+    for (uint32_t idx = 0; idx < size; ++idx) {
+      const NapiValue item(m_array.Get(idx));
+      const auto num = [&item]() {
+        if constexpr (std::is_same_v<NumT, double>) {
+          return item.read_double();
+        } else if constexpr (std::is_same_v<NumT, int64_t>) {
+          return item.read_i64();
+        } else {
+          return item.read_u64();
+        }
+      }();
+      if (!num.has_value()) [[unlikely]] {
+        return UnexpJsonError(num.error());
+      }
+      numbers.push_back(num.value());
+    }
+    return ExpType<void>();
+  }
+
+  inline NapiArrayIterator& NapiArrayIterator::operator++() {
+    if (!m_array.IsEmpty() && m_index < m_array.Length()) {
+      ++m_index;
+    }
+    return *this;
+  }
+
+  inline bool NapiArrayIterator::operator==(std::default_sentinel_t) const {
+    return m_array.IsEmpty() || m_index == m_array.Length();
+  }
+
+  // -------------------------------------------
+  inline NapiObjectIterator::NapiObjectIterator(const Napi::Object object)
+      : m_object(object) {
+    auto maybe = object.GetPropertyNames();
+    if (maybe.IsArray()) {
+      m_keys = maybe.As<Napi::Array>();
+    }
+  }
+
+  inline NapiObjectIterator::value_type NapiObjectIterator::operator*() const {
+    if (m_keys.IsEmpty()) {
+      return make_json_error(JsonErrorTypes::Invalid, "Object with no keys"sv);
+    }
+
+    const auto key = m_keys.Get(m_index);
+    if (key.IsEmpty()) {
+      return make_json_error(JsonErrorTypes::Invalid, "Empty key"sv);
+    } else if (!key.IsString() && !key.IsSymbol()) {
+      return make_json_error(JsonErrorTypes::WrongType,
+                             "Object's key is not a string"sv);
+    }
+
+    const auto val = m_object.Get(key);
+    if (val.IsEmpty()) {
+      return make_json_error(JsonErrorTypes::Invalid, "Empty value"sv);
+    }
+    return NapiObjectPair(key.ToString(), NapiValue(val));
+  }
+
+  inline NapiObjectIterator& NapiObjectIterator::operator++() {
+    if (!m_keys.IsEmpty() && m_index < m_keys.Length()) {
+      ++m_index;
+    }
+    return *this;
+  }
+
+  inline bool NapiObjectIterator::operator==(std::default_sentinel_t) const {
+    return m_keys.IsEmpty() || m_index == m_keys.Length();
+  }
+
+  // -------------------------------------------
+  inline bool NapiObject::has_field(const std::string_view key) const {
+    return m_object.Has(
+        Napi::String::New(m_object.Env(), key.data(), key.size()));
+  }
+
+  inline ExpType<NapiValue>
+  NapiObject::read_field(const std::string_view key) const {
+    const auto napi_key =
+        Napi::String::New(m_object.Env(), key.data(), key.size());
+    if (!m_object.Has(napi_key)) {
+      return make_json_error(JsonErrorTypes::Invalid, "missing key"sv);
+    }
+    return NapiValue(m_object.Get(napi_key));
+  }
+
+} // namespace JsonTypedefCodeGen::Reader::Direct
+
 #endif
 
 #ifdef USE_OUT_NAPI
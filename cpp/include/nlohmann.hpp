@@ -6,14 +6,305 @@
 
 #ifdef USE_IN_NLOH
 
+#include "direct_reader.hpp"
 #include "json_reader.hpp"
 
 namespace JsonTypedefCodeGen::Reader {
 
-  ExpType<JsonValue> nlohmann_root_value(const nlohmann::json root);
+  // the values point inside "root", which must outlive them
+  ExpType<JsonValue> nlohmann_root_value(const nlohmann::json& root);
+  ExpType<JsonValue> nlohmann_root_value(const nlohmann::json&& root) = delete;
+
+  // same, but all the reader objects are allocated from the session pool
+  ExpType<JsonValue> nlohmann_root_value(const nlohmann::json& root,
+                                         Session& session);
+  ExpType<JsonValue> nlohmann_root_value(const nlohmann::json&& root,
+                                         Session& session) = delete;
 
 }
 
+namespace JsonTypedefCodeGen::Reader::Direct {
+
+  using namespace std::string_view_literals;
+
+  class NlohArray;
+  class NlohObject;
+
+  // borrows the nlohmann::json, it must outlive the reader
+  class NlohValue {
+  private:
+    const nlohmann::json* m_value;
+
+  public:
+    using Array = NlohArray;
+    using Object = NlohObject;
+
+    NlohValue() = delete;
+    NlohValue(const nlohmann::json& value) : m_value(&value) {}
+    NlohValue(const nlohmann::json&& value) = delete;
+
+    JsonTypes get_type() const;
+
+    ExpType<bool> is_null() const;
+    ExpType<bool> read_bool() const;
+    ExpType<double> read_double() const;
+    ExpType<uint64_t> read_u64() const;
+    ExpType<int64_t> read_i64() const;
+    ExpType<std::string> read_str() const;
+    ExpType<std::string_view> read_str_view() const;
+    ExpType<NlohArray> read_array() const;
+    ExpType<NlohObject> read_object() const;
+
+    NumberType get_number_type() const;
+  };
+
+  class NlohArrayIterator {
+  private:
+    using NlohVectorIter = nlohmann::json::array_t::const_iterator;
+
+    NlohVectorIter m_iter, m_end;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<NlohValue>;
+
+    NlohArrayIterator() = delete;
+    NlohArrayIterator(NlohVectorIter begin, NlohVectorIter end)
+        : m_iter(begin), m_end(end) {}
+
+    inline value_type operator*() const { return NlohValue(*m_iter); }
+    inline NlohArrayIterator& operator++() {
+      if (m_iter != m_end) {
+        ++m_iter;
+      }
+      return *this;
+    }
+    inline void operator++(int) { ++(*this); }
+
+    inline bool operator==(std::default_sentinel_t) const {
+      return m_iter == m_end;
+    }
+  };
+
+  class NlohArray {
+  private:
+    const nlohmann::json::array_t* m_array;
+
+  public:
+    using Value = NlohValue;
+
+    NlohArray() = delete;
+    NlohArray(const nlohmann::json::array_t& arr) : m_array(&arr) {}
+
+    inline NlohArrayIterator begin() const {
+      return NlohArrayIterator(m_array->begin(), m_array->end());
+    }
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    inline std::size_t size_hint() const { return m_array->size(); }
+
+    template <typename NumT>
+      requires std::is_same_v<NumT, double> || std::is_same_v<NumT, int64_t> ||
+               std::is_same_v<NumT, uint64_t>
+    ExpType<void> read_numbers_into(std::vector<NumT>& numbers) const {
+      numbers.reserve(numbers.size() + size_hint());
+      for (const auto& item : *m_array) {
+        if (!item.is_number()) [[unlikely]] {
+          return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+        }
+        numbers.push_back(item.get<NumT>());
+      }
+      return ExpType<void>();
+    }
+  };
+
+  using NlohObjectPair = std::pair<std::string_view, NlohValue>;
+
+  class NlohObjectIterator {
+  private:
+    using NlohMapIter = nlohmann::json::object_t::const_iterator;
+
+    NlohMapIter m_iter, m_end;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<NlohObjectPair>;
+
+    NlohObjectIterator() = delete;
+    NlohObjectIterator(NlohMapIter begin, NlohMapIter end)
+        : m_iter(begin), m_end(end) {}
+
+    inline value_type operator*() const {
+      return NlohObjectPair{m_iter->first, NlohValue(m_iter->second)};
+    }
+    inline NlohObjectIterator& operator++() {
+      if (m_iter != m_end) {
+        ++m_iter;
+      }
+      return *this;
+    }
+    inline void operator++(int) { ++(*this); }
+
+    inline bool operator==(std::default_sentinel_t) const {
+      return m_iter == m_end;
+    }
+  };
+
+  class NlohObject {
+  private:
+    const nlohmann::json::object_t* m_object;
+
+  public:
+    using Value = NlohValue;
+
+    NlohObject() = delete;
+    NlohObject(const nlohmann::json::object_t& obj) : m_object(&obj) {}
+
+    inline NlohObjectIterator begin() const {
+      return NlohObjectIterator(m_object->begin(), m_object->end());
+    }
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    inline std::size_t size_hint() const { return m_object->size(); }
+
+    ExpType<std::optional<std::string_view>>
+    read_str_field(const std::string_view key) const;
+  };
+
+  inline ExpType<NlohValue> nlohmann_root_value(const nlohmann::json& root) {
+    switch (root.type()) {
+    case nlohmann::json::value_t::binary:
+      return make_json_error(JsonErrorTypes::Invalid,
+                             "binary type not supported"sv);
+    case nlohmann::json::value_t::discarded:
+      return make_json_error(JsonErrorTypes::Invalid,
+                             "discarded type not supported"sv);
+    default:
+      break;
+    }
+    return NlohValue(root);
+  }
+  ExpType<NlohValue> nlohmann_root_value(const nlohmann::json&& root) = delete;
+
+  // -------------------------------------------
+  inline JsonTypes NlohValue::get_type() const {
+    using NType = nlohmann::json::value_t;
+    switch (m_value->type()) {
+    case NType::null:
+      return JsonTypes::Null;
+    case NType::object:
+      return JsonTypes::Object;
+    case NType::array:
+      return JsonTypes::Array;
+    case NType::string:
+      return JsonTypes::String;
+    case NType::boolean:
+      return JsonTypes::Bool;
+    case NType::number_integer:
+    case NType::number_unsigned:
+    case NType::number_float:
+      return JsonTypes::Number;
+    case NType::binary:
+    case NType::discarded:
+    default:
+      return JsonTypes::Invalid;
+    }
+  }
+
+  inline ExpType<bool> NlohValue::is_null() const {
+    return m_value->is_null();
+  }
+
+  inline ExpType<bool> NlohValue::read_bool() const {
+    if (const auto* val = m_value->get_ptr<const bool*>(); val != nullptr) {
+      return *val;
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a boolean"sv);
+  }
+
+  inline ExpType<double> NlohValue::read_double() const {
+    if (m_value->is_number()) {
+      return m_value->get<double>();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+  }
+
+  inline ExpType<uint64_t> NlohValue::read_u64() const {
+    if (m_value->is_number()) {
+      return m_value->get<uint64_t>();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+  }
+
+  inline ExpType<int64_t> NlohValue::read_i64() const {
+    if (m_value->is_number()) {
+      return m_value->get<int64_t>();
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a number"sv);
+  }
+
+  inline ExpType<std::string> NlohValue::read_str() const {
+    if (const auto* str = m_value->get_ptr<const nlohmann::json::string_t*>();
+        str != nullptr) {
+      return *str;
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a string"sv);
+  }
+
+  inline ExpType<std::string_view> NlohValue::read_str_view() const {
+    if (const auto* str = m_value->get_ptr<const nlohmann::json::string_t*>();
+        str != nullptr) {
+      return std::string_view(*str);
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not a string"sv);
+  }
+
+  inline ExpType<NlohArray> NlohValue::read_array() const {
+    if (const auto* arr = m_value->get_ptr<const nlohmann::json::array_t*>();
+        arr != nullptr) {
+      return NlohArray(*arr);
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not an array"sv);
+  }
+
+  inline ExpType<NlohObject> NlohValue::read_object() const {
+    if (const auto* obj = m_value->get_ptr<const nlohmann::json::object_t*>();
+        obj != nullptr) {
+      return NlohObject(*obj);
+    }
+    return make_json_error(JsonErrorTypes::WrongType, "not an object"sv);
+  }
+
+  inline ExpType<std::optional<std::string_view>>
+  NlohObject::read_str_field(const std::string_view key) const {
+    const auto fnd = m_object->find(key);
+    if (fnd == m_object->end()) {
+      return std::nullopt;
+    }
+    return NlohValue(fnd->second).read_str_view();
+  }
+
+  inline NumberType NlohValue::get_number_type() const {
+    using NType = nlohmann::json::value_t;
+    switch (m_value->type()) {
+    case NType::number_float:
+      return NumberType::Double;
+    case NType::number_integer:
+      return NumberType::I64;
+    case NType::number_unsigned:
+      return NumberType::U64;
+    default:
+      break;
+    }
+    return NumberType::NaN;
+  }
+
+} // namespace JsonTypedefCodeGen::Reader::Direct
+
 #endif
 
 #ifdef USE_OUT_NLOH
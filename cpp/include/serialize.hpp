@@ -2,126 +2,145 @@
 
 #ifdef IMPL_SERIALIZE
 
+#include "direct_writer.hpp"
 #include "json_data.hpp"
 #include "json_writer.hpp"
 
 #include <memory>
 
-// utility functions for the serialized generated code
+// utility functions for the serialized generated code, templates over the
+// writer so that a concrete one is called without indirection
 
 namespace JsonTypedefCodeGen::Serialize {
 
   namespace JDt = JsonTypedefCodeGen::Data;
-  namespace JWt = JsonTypedefCodeGen::Writer;
+  namespace JWd = JsonTypedefCodeGen::Writer::Direct;
   using strview = std::string_view;
 
   template <typename Type> struct Serialize;
 
   template <> struct Serialize<std::nullptr_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const std::nullptr_t) {
       return serializer.write_null();
     }
   };
 
   template <> struct Serialize<bool> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const bool value) {
       return serializer.write_bool(value);
     }
   };
 
   template <> struct Serialize<int8_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const int8_t value) {
       return serializer.write_i64(value);
     }
   };
   template <> struct Serialize<int16_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const int16_t value) {
       return serializer.write_i64(value);
     }
   };
   template <> struct Serialize<int32_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const int32_t value) {
       return serializer.write_i64(value);
     }
   };
   template <> struct Serialize<int64_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const int64_t value) {
       return serializer.write_i64(value);
     }
   };
 
   template <> struct Serialize<uint8_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const uint8_t value) {
       return serializer.write_u64(value);
     }
   };
   template <> struct Serialize<uint16_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const uint16_t value) {
       return serializer.write_u64(value);
     }
   };
   template <> struct Serialize<uint32_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const uint32_t value) {
       return serializer.write_u64(value);
     }
   };
   template <> struct Serialize<uint64_t> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const uint64_t value) {
       return serializer.write_u64(value);
     }
   };
 
   template <> struct Serialize<float> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const float value) {
-      return serializer.write_double(value);
+      return serializer.write_float(value);
     }
   };
   template <> struct Serialize<double> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const double value) {
       return serializer.write_double(value);
     }
   };
 
   template <> struct Serialize<strview> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const strview value) {
       return serializer.write_str(value);
     }
   };
 
   template <> struct Serialize<std::string> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const strview value) {
       return serializer.write_str(value);
     }
   };
 
   template <> struct Serialize<JDt::JsonArray> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const JDt::JsonArray value) {
       return serializer.write(value);
     }
   };
   template <> struct Serialize<JDt::JsonObject> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const JDt::JsonObject value) {
       return serializer.write(value);
     }
   };
   template <> struct Serialize<JDt::JsonValue> {
-    static inline ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static inline ExpType<void> serialize(JWriter& serializer,
                                           const JDt::JsonValue value) {
       return serializer.write(value);
     }
@@ -134,7 +153,8 @@ namespace JsonTypedefCodeGen::Serialize {
 
   template <typename Type> struct Serialize<std::vector<Type>> {
     using SubType = Serialize<Type>;
-    static ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static ExpType<void> serialize(JWriter& serializer,
                                    const std::vector<Type>& values) {
       SHORT_EXP(serializer.start_array());
       for (const auto& item : values) {
@@ -146,7 +166,8 @@ namespace JsonTypedefCodeGen::Serialize {
 
   template <typename Type> struct Serialize<JsonMap<Type>> {
     using SubType = Serialize<Type>;
-    static ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static ExpType<void> serialize(JWriter& serializer,
                                    const JsonMap<Type>& values) {
       SHORT_EXP(serializer.start_object());
       for (const auto& [key, item] : values) {
@@ -159,7 +180,8 @@ namespace JsonTypedefCodeGen::Serialize {
 
   template <typename Nullable> struct Serialize<std::unique_ptr<Nullable>> {
     using SubNull = Serialize<Nullable>;
-    static ExpType<void> serialize(JWt::Serializer& serializer,
+    template <JWd::Serializer JWriter>
+    static ExpType<void> serialize(JWriter& serializer,
                                    const std::unique_ptr<Nullable>& value) {
       if (!!value) {
         return SubNull::serialize(serializer, *value);
@@ -2,14 +2,693 @@
 
 #ifdef USE_SIMD
 
+#include "direct_reader.hpp"
 #include "json_reader.hpp"
 #include "simdjson.h"
 
+#include <filesystem>
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 namespace JsonTypedefCodeGen::Reader {
 
+  // with "count_items", the arrays and objects are counted before being read
+  // to reserve the vectors, see Direct::SimdArray::size_hint
+  ExpType<JsonValue> simdjson_root_value(
+      const simdjson::simdjson_result<simdjson::ondemand::value> root,
+      const bool count_items = false);
+
+  // same, but all the reader objects are allocated from the session pool
   ExpType<JsonValue> simdjson_root_value(
-      const simdjson::simdjson_result<simdjson::ondemand::value> root);
+      const simdjson::simdjson_result<simdjson::ondemand::value> root,
+      Session& session, const bool count_items = false);
+
+  namespace Direct {
+    class SimdValue;
+  }
+
+  // owns the padded input, the document, and a parser leased from a small
+  // per-thread pool, given back when destroyed so the next document reuses
+  // its buffers. The values read from it must not outlive it
+  class SimdDocument {
+  private:
+    std::unique_ptr<simdjson::ondemand::parser> m_parser;
+    simdjson::padded_string m_json;
+    // a mapped file, when the input doesn't come from m_json
+    void* m_mapping = nullptr;
+    std::size_t m_mapping_size = 0;
+    simdjson::ondemand::document m_document;
+    simdjson::error_code m_error = simdjson::SUCCESS;
+    Session m_session;
+
+    SimdDocument(void* mapping, const std::size_t mapping_size,
+                 const simdjson::padded_string_view json);
+
+  public:
+    explicit SimdDocument(const std::string_view json);
+    // a std::string or a literal would convert to both the view and the
+    // padded string otherwise
+    explicit SimdDocument(const std::string& json);
+    explicit SimdDocument(const char* json);
+    explicit SimdDocument(simdjson::padded_string&& json);
+
+    // maps the file in memory instead of copying it into a padded string,
+    // the padding is zero filled pages mapped after it. Falls back to loading
+    // the file where mmap isn't available
+    static ExpType<std::unique_ptr<SimdDocument>>
+    from_file(const std::filesystem::path& path);
+
+    SimdDocument(const SimdDocument&) = delete;
+    SimdDocument(SimdDocument&&) = delete;
+    ~SimdDocument();
+
+    SimdDocument& operator=(const SimdDocument&) = delete;
+    SimdDocument& operator=(SimdDocument&&) = delete;
+
+    // the reader objects are allocated from the document's session. Each call
+    // starts over from the beginning, invalidating the previous values.
+    // "count_items" as in simdjson_root_value
+    ExpType<JsonValue> root(const bool count_items = false);
+    ExpType<Direct::SimdValue> direct_root(const bool count_items = false);
+  };
 
 } // namespace JsonTypedefCodeGen::Reader
 
+namespace JsonTypedefCodeGen::Reader::Direct {
+
+  UnexpJsonError make_simdjson_error(const simdjson::error_code err_type);
+
+  template <typename Type>
+  inline ExpType<Type> map_simd_data(simdjson::simdjson_result<Type> data) {
+    const auto err_type = data.error();
+    [[likely]] if (err_type == simdjson::SUCCESS) {
+      return ExpType<Type>(std::move(data.value_unsafe()));
+    }
+    return make_simdjson_error(err_type);
+  }
+
+  class SimdArray;
+  class SimdObject;
+
+  class SimdValue {
+  private:
+    mutable simdjson::ondemand::value m_value;
+    // decoded once by get_number_type, for the read following it
+    mutable std::optional<simdjson::ondemand::number> m_number;
+    // passed down to the arrays and objects read from it
+    bool m_count_items;
+
+  public:
+    using Array = SimdArray;
+    using Object = SimdObject;
+
+    SimdValue() = delete;
+    SimdValue(const simdjson::ondemand::value val, const bool count_items)
+        : m_value(val), m_count_items(count_items) {}
+
+    JsonTypes get_type() const;
+
+    ExpType<bool> is_null() const;
+    ExpType<bool> read_bool() const;
+    ExpType<double> read_double() const;
+    ExpType<uint64_t> read_u64() const;
+    ExpType<int64_t> read_i64() const;
+    ExpType<std::string> read_str() const;
+    ExpType<std::string_view> read_str_view() const;
+    ExpType<SimdArray> read_array() const;
+    ExpType<SimdObject> read_object() const;
+
+    NumberType get_number_type() const;
+  };
+
+  class SimdArrayIterator {
+  private:
+    using ArrIter = simdjson::ondemand::array_iterator;
+    using ArrIterResult = simdjson::simdjson_result<ArrIter>;
+
+    ArrIterResult m_iter;
+    ArrIter m_end;
+    bool m_count_items;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<SimdValue>;
+
+    SimdArrayIterator() = delete;
+    SimdArrayIterator(const ArrIterResult begin, ArrIter end,
+                      const bool count_items)
+        : m_iter(begin), m_end(end), m_count_items(count_items) {}
+
+    value_type operator*() const;
+    SimdArrayIterator& operator++();
+    inline void operator++(int) { ++(*this); }
+
+    bool operator==(std::default_sentinel_t) const;
+  };
+
+  class SimdArray {
+  private:
+    mutable simdjson::ondemand::array m_array;
+    bool m_count_items;
+
+  public:
+    using Value = SimdValue;
+
+    SimdArray() = delete;
+    SimdArray(const simdjson::ondemand::array arr, const bool count_items)
+        : m_array(arr), m_count_items(count_items) {}
+
+    SimdArrayIterator begin() const;
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    // counting walks the array once more before it's read, so it's only done
+    // when the root was read with "count_items". Must be called before
+    // iterating
+    inline std::size_t size_hint() const {
+      std::size_t count = 0;
+      if (m_count_items &&
+          m_array.count_elements().get(count) == simdjson::SUCCESS) {
+        return count;
+      }
+      return 0;
+    }
+
+    // consumes the array, like iterating it
+    template <typename NumT>
+      requires std::is_same_v<NumT, double> || std::is_same_v<NumT, int64_t> ||
+               std::is_same_v<NumT, uint64_t>
+    ExpType<void> read_numbers_into(std::vector<NumT>& numbers) const {
+      numbers.reserve(numbers.size() + size_hint());
+      for (auto item : m_array) {
+        NumT num;
+        if (const auto err_type = item.get(num); err_type != simdjson::SUCCESS)
+            [[unlikely]] {
+          return make_simdjson_error(err_type);
+        }
+        numbers.push_back(num);
+      }
+      return ExpType<void>();
+    }
+  };
+
+  using SimdObjectPair = std::pair<std::string_view, SimdValue>;
+
+  class SimdObjectIterator {
+  private:
+    using ObjIter = simdjson::ondemand::object_iterator;
+    using ObjIterResult = simdjson::simdjson_result<ObjIter>;
+
+    ObjIterResult m_iter;
+    ObjIter m_end;
+    bool m_count_items;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<SimdObjectPair>;
+
+    SimdObjectIterator() = delete;
+    SimdObjectIterator(const ObjIterResult begin, ObjIter end,
+                       const bool count_items)
+        : m_iter(begin), m_end(end), m_count_items(count_items) {}
+
+    value_type operator*() const;
+    SimdObjectIterator& operator++();
+    inline void operator++(int) { ++(*this); }
+
+    bool operator==(std::default_sentinel_t) const;
+  };
+
+  class SimdObject {
+  private:
+    mutable simdjson::ondemand::object m_object;
+    bool m_count_items;
+
+  public:
+    using Value = SimdValue;
+
+    SimdObject() = delete;
+    SimdObject(const simdjson::ondemand::object obj, const bool count_items)
+        : m_object(obj), m_count_items(count_items) {}
+
+    SimdObjectIterator begin() const;
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    // see SimdArray::size_hint
+    inline std::size_t size_hint() const {
+      std::size_t count = 0;
+      if (m_count_items &&
+          m_object.count_fields().get(count) == simdjson::SUCCESS) {
+        return count;
+      }
+      return 0;
+    }
+
+    ExpType<std::optional<std::string_view>>
+    read_str_field(const std::string_view key) const;
+  };
+
+  // "count_items" as in Reader::simdjson_root_value
+  inline ExpType<SimdValue> simdjson_root_value(
+      const simdjson::simdjson_result<simdjson::ondemand::value> root,
+      const bool count_items = false) {
+    return map_simd_data(root).transform([count_items](const auto val) {
+      return SimdValue(val, count_items);
+    });
+  }
+
+  struct SimdStreamOptions {
+    // bytes indexed at once, larger than the largest document
+    std::size_t batch_size = simdjson::ondemand::DEFAULT_BATCH_SIZE;
+    // index the next batch in a background thread, if simdjson has threads
+    bool threaded = true;
+    // see simdjson_root_value
+    bool count_items = false;
+  };
+
+  // deserialize each document of a stream, like newline-delimited JSON.
+  // "deserialize" takes a SimdValue and returns an ExpType<T>, like the
+  // generated deserializers. "cb" gets the byte offset of each document and
+  // its ExpType<T>, a document failing to deserialize doesn't stop the stream.
+  // The values only live during their callback.
+  // The returned error is for the stream itself, simdjson can't go past a
+  // malformed document
+  template <typename Deserialize, typename Cb>
+  ExpType<void> simdjson_for_each_document(
+      simdjson::ondemand::parser& parser,
+      const simdjson::padded_string_view json, Deserialize&& deserialize,
+      Cb&& cb, const SimdStreamOptions options = {}) {
+#ifdef SIMDJSON_THREADS_ENABLED
+    parser.threaded = options.threaded;
+#endif
+
+    simdjson::ondemand::document_stream stream;
+    if (const auto err_type =
+            parser.iterate_many(json.data(), json.size(), options.batch_size)
+                .get(stream);
+        err_type != simdjson::SUCCESS) [[unlikely]] {
+      return make_simdjson_error(err_type);
+    }
+
+    const auto stream_error = [](const simdjson::error_code err_type,
+                                 const std::size_t offset) {
+      return make_json_error(
+          JsonErrorTypes::Invalid,
+          std::format("{} at byte {}", simdjson::error_message(err_type),
+                      offset));
+    };
+
+    for (auto iter = stream.begin(); iter != stream.end(); ++iter) {
+      auto doc = *iter;
+      if (const auto err_type = doc.error(); err_type != simdjson::SUCCESS)
+          [[unlikely]] {
+        return stream_error(err_type, iter.current_index());
+      }
+
+      cb(iter.current_index(),
+         flatten_expected(simdjson_root_value(doc.get_value(),
+                                              options.count_items)
+                              .transform([&](const SimdValue& val) {
+                                return deserialize(val);
+                              })));
+    }
+
+    if (const auto truncated = stream.truncated_bytes(); truncated != 0) {
+      return stream_error(simdjson::INCOMPLETE_ARRAY_OR_OBJECT,
+                          json.size() - truncated);
+    }
+    return ExpType<void>();
+  }
+
+  struct SimdParallelOptions {
+    // array items deserialized by a thread at once
+    std::size_t chunk_size = 4096;
+    // 0 for the hardware concurrency
+    std::size_t threads = 0;
+    // for the items' arrays and objects, see simdjson_root_value
+    bool count_items = false;
+  };
+
+  // calls "fn(worker, chunk)" for the chunks [0, count) from "threads"
+  // workers, each taking the next chunk not started. Once "fn" returns false
+  // the chunks not started yet are skipped, the ones before it are all done
+  void parallel_chunks(const std::size_t count, const std::size_t threads,
+                       const std::function<bool(std::size_t, std::size_t)>& fn);
+
+  // deserialize a top-level array in parallel, "deserialize" takes a
+  // SimdValue and returns an ExpType<T> like the generated deserializers, it
+  // is called from several threads.
+  // The array is first skimmed to find the bounds of its items, then each
+  // chunk of items is copied into its own padded buffer and parsed again as
+  // an array by a worker. The result, or the first error by index, is the
+  // same as the serial path
+  template <typename Deserialize>
+  auto simdjson_parallel_array(const simdjson::padded_string_view json,
+                               Deserialize&& deserialize,
+                               const SimdParallelOptions options = {})
+      -> ExpType<std::vector<typename std::invoke_result_t<
+          Deserialize&, const SimdValue&>::value_type>> {
+    using Type = typename std::invoke_result_t<Deserialize&,
+                                               const SimdValue&>::value_type;
+
+    // item bounds, the scan stops at the first malformed item
+    std::vector<std::string_view> items;
+    std::optional<JsonError> scan_error;
+    {
+      simdjson::ondemand::parser parser;
+      simdjson::ondemand::document doc;
+      simdjson::ondemand::array array;
+      if (const auto err_type = parser.iterate(json).get(doc);
+          err_type != simdjson::SUCCESS) [[unlikely]] {
+        return make_simdjson_error(err_type);
+      }
+      if (const auto err_type = doc.get_array().get(array);
+          err_type != simdjson::SUCCESS) [[unlikely]] {
+        return make_simdjson_error(err_type);
+      }
+
+      for (auto item : array) {
+        std::string_view raw;
+        if (const auto err_type = item.raw_json().get(raw);
+            err_type != simdjson::SUCCESS) [[unlikely]] {
+          scan_error.emplace(make_simdjson_error(err_type).error());
+          break;
+        }
+        items.push_back(raw);
+      }
+    }
+
+    const std::size_t chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+    const std::size_t chunks = (items.size() + chunk_size - 1) / chunk_size;
+    const std::size_t threads = std::min<std::size_t>(
+        chunks, options.threads != 0
+                    ? options.threads
+                    : std::max(std::thread::hardware_concurrency(), 1u));
+
+    std::vector<std::vector<Type>> results(chunks);
+    std::vector<std::optional<JsonError>> errors(chunks);
+    std::vector<simdjson::ondemand::parser> parsers(threads);
+    std::vector<std::vector<char>> buffers(threads);
+
+    parallel_chunks(chunks, threads, [&](const std::size_t worker,
+                                         const std::size_t chunk) {
+      const auto first = chunk * chunk_size;
+      const auto last = std::min(first + chunk_size, items.size()) - 1;
+      const std::string_view raw(items[first].data(),
+                                 items[last].data() + items[last].size());
+
+      // the items and the commas between them, back in brackets
+      auto& buffer = buffers[worker];
+      buffer.resize(raw.size() + 2 + simdjson::SIMDJSON_PADDING);
+      buffer[0] = '[';
+      std::copy(raw.begin(), raw.end(), buffer.begin() + 1);
+      buffer[raw.size() + 1] = ']';
+      const simdjson::padded_string_view chunk_json(
+          buffer.data(), raw.size() + 2, buffer.size());
+
+      auto& result = results[chunk];
+      result.reserve(last - first + 1);
+      const auto add_item = [&](const SimdValue& item) -> ExpType<void> {
+        if (auto exp_res = deserialize(item); exp_res.has_value()) {
+          result.emplace_back(std::move(exp_res.value()));
+          return ExpType<void>();
+        } else {
+          return UnexpJsonError(std::move(exp_res.error()));
+        }
+      };
+      auto exp =
+          simdjson_root_value(parsers[worker].iterate(chunk_json).get_value(),
+                              options.count_items)
+              .and_then([&](const SimdValue& array) {
+                return json_array_for_each(array, add_item);
+              });
+      if (!exp.has_value()) {
+        errors[chunk].emplace(std::move(exp.error()));
+        return false;
+      }
+      return true;
+    });
+
+    for (auto& error : errors) {
+      if (error.has_value()) {
+        return UnexpJsonError(std::move(error.value()));
+      }
+    }
+    if (scan_error.has_value()) {
+      return UnexpJsonError(std::move(scan_error.value()));
+    }
+
+    std::vector<Type> result;
+    result.reserve(items.size());
+    for (auto& chunk : results) {
+      std::move(chunk.begin(), chunk.end(), std::back_inserter(result));
+    }
+    return result;
+  }
+
+  // -------------------------------------------
+  constexpr JsonTypes map_simd_type(const simdjson::ondemand::json_type type) {
+    using simdjson::ondemand::json_type;
+    switch (type) {
+    case json_type::array:
+      return JsonTypes::Array;
+    case json_type::boolean:
+      return JsonTypes::Bool;
+    case json_type::null:
+      return JsonTypes::Null;
+    case json_type::number:
+      return JsonTypes::Number;
+    case json_type::object:
+      return JsonTypes::Object;
+    case json_type::string:
+      return JsonTypes::String;
+    default:
+      return JsonTypes::Invalid;
+    }
+  }
+
+  inline JsonTypes SimdValue::get_type() const {
+    if (auto tp = m_value.type(); tp.error() == simdjson::SUCCESS) {
+      return map_simd_type(tp.value_unsafe());
+    }
+    return JsonTypes::Invalid;
+  }
+
+  inline ExpType<bool> SimdValue::is_null() const {
+    auto tp = m_value.type();
+    return tp.error() == simdjson::SUCCESS &&
+           tp.value_unsafe() == simdjson::ondemand::json_type::null;
+  }
+
+  inline ExpType<bool> SimdValue::read_bool() const {
+    return map_simd_data(m_value.get_bool());
+  }
+
+  inline ExpType<double> SimdValue::read_double() const {
+    if (m_number.has_value()) {
+      return m_number->as_double();
+    }
+    return map_simd_data(m_value.get_double());
+  }
+
+  inline ExpType<uint64_t> SimdValue::read_u64() const {
+    if (m_number.has_value()) {
+      if (m_number->is_uint64()) {
+        return m_number->get_uint64();
+      }
+      if (m_number->is_int64() && m_number->get_int64() >= 0) {
+        return static_cast<uint64_t>(m_number->get_int64());
+      }
+    }
+    // the errors come from simdjson
+    return map_simd_data(m_value.get_uint64());
+  }
+
+  inline ExpType<int64_t> SimdValue::read_i64() const {
+    if (m_number.has_value() && m_number->is_int64()) {
+      return m_number->get_int64();
+    }
+    return map_simd_data(m_value.get_int64());
+  }
+
+  inline ExpType<std::string> SimdValue::read_str() const {
+    return map_simd_data(m_value.get_string())
+        .transform([](const std::string_view sv) {
+          return std::string(sv);
+        });
+  }
+
+  inline ExpType<std::string_view> SimdValue::read_str_view() const {
+    return map_simd_data(m_value.get_string());
+  }
+
+  inline ExpType<SimdArray> SimdValue::read_array() const {
+    return map_simd_data(m_value.get_array()).transform([this](const auto arr) {
+      return SimdArray(arr, m_count_items);
+    });
+  }
+
+  inline ExpType<SimdObject> SimdValue::read_object() const {
+    return map_simd_data(m_value.get_object()).transform(
+        [this](const auto obj) { return SimdObject(obj, m_count_items); });
+  }
+
+  inline NumberType SimdValue::get_number_type() const {
+    if (get_type() != JsonTypes::Number) {
+      return NumberType::NaN;
+    }
+
+    if (!m_number.has_value()) {
+      if (auto num = m_value.get_number(); num.error() == simdjson::SUCCESS) {
+        m_number = num.value_unsafe();
+      } else {
+        // big integers, classified from the text
+        if (m_value.is_integer()) {
+          return m_value.is_negative() ? NumberType::I64 : NumberType::U64;
+        }
+        return NumberType::Double;
+      }
+    }
+
+    using simdjson::ondemand::number_type;
+    switch (m_number->get_number_type()) {
+    case number_type::signed_integer:
+      // the non-negative integers are read as unsigned
+      return m_number->get_int64() < 0 ? NumberType::I64 : NumberType::U64;
+    case number_type::unsigned_integer:
+      return NumberType::U64;
+    default:
+      return NumberType::Double;
+    }
+  }
+
+  // -------------------------------------------
+  inline SimdArrayIterator::value_type SimdArrayIterator::operator*() const {
+    auto err_type = m_iter.error();
+    if (err_type == simdjson::SUCCESS) {
+      auto unsafe_val = m_iter.value_unsafe();
+      auto val = *unsafe_val;
+      err_type = val.error();
+      if (err_type == simdjson::SUCCESS) {
+        return SimdValue(val.value_unsafe(), m_count_items);
+      }
+    }
+    return make_simdjson_error(err_type);
+  }
+
+  inline SimdArrayIterator& SimdArrayIterator::operator++() {
+    if (m_iter.error() == simdjson::SUCCESS) {
+      if (m_iter.value_unsafe() == m_end) {
+        // if it reached the end, invalidate it
+        m_iter = ArrIterResult(simdjson::OUT_OF_BOUNDS);
+      } else {
+        ++(m_iter.value_unsafe());
+      }
+    }
+    return *this;
+  }
+
+  inline bool SimdArrayIterator::operator==(std::default_sentinel_t) const {
+    return m_iter.error() != simdjson::SUCCESS ||
+           m_iter.value_unsafe() == m_end;
+  }
+
+  inline SimdArrayIterator SimdArray::begin() const {
+    using ArrIter = simdjson::ondemand::array_iterator;
+    auto first = m_array.begin(), last = m_array.end();
+    ArrIter end; // default and invalid, never used if there's an error
+
+    if (const auto err_type = last.error(); err_type != simdjson::SUCCESS) {
+      // forward the error on the first iterator
+      first = simdjson::simdjson_result<ArrIter>(err_type);
+    } else {
+      end = last.value_unsafe();
+    }
+    return SimdArrayIterator(first, end, m_count_items);
+  }
+
+  // -------------------------------------------
+  // keys without a backslash, nearly all of them, are the raw bytes of the
+  // document, compared as they are with the generated entries. The others
+  // are unescaped into the parser's string buffer
+  inline SimdObjectIterator::value_type SimdObjectIterator::operator*() const {
+    auto err_type = m_iter.error();
+    if (err_type == simdjson::SUCCESS) {
+      auto unsafe_val = m_iter.value_unsafe();
+      auto val = *unsafe_val;
+      err_type = val.error();
+      if (err_type == simdjson::SUCCESS) {
+        auto& field = val.value_unsafe();
+        const auto raw_key = field.escaped_key();
+        if (raw_key.find('\\') == std::string_view::npos) [[likely]] {
+          return SimdObjectPair{raw_key,
+                                SimdValue(field.value(), m_count_items)};
+        }
+        std::string_view key;
+        err_type = field.unescaped_key().get(key);
+        if (err_type == simdjson::SUCCESS) {
+          return SimdObjectPair{key, SimdValue(field.value(), m_count_items)};
+        }
+      }
+    }
+    return make_simdjson_error(err_type);
+  }
+
+  inline SimdObjectIterator& SimdObjectIterator::operator++() {
+    if (m_iter.error() == simdjson::SUCCESS) {
+      if (m_iter.value_unsafe() == m_end) {
+        // if it reached the end, invalidate it
+        m_iter = ObjIterResult(simdjson::OUT_OF_BOUNDS);
+      } else {
+        ++(m_iter.value_unsafe());
+      }
+    }
+    return *this;
+  }
+
+  inline bool SimdObjectIterator::operator==(std::default_sentinel_t) const {
+    return m_iter.error() != simdjson::SUCCESS ||
+           m_iter.value_unsafe() == m_end;
+  }
+
+  inline SimdObjectIterator SimdObject::begin() const {
+    using ObjIter = simdjson::ondemand::object_iterator;
+    auto first = m_object.begin(), last = m_object.end();
+    ObjIter end; // default and invalid, never used if there's an error
+
+    if (const auto err_type = last.error(); err_type != simdjson::SUCCESS) {
+      // forward the error on the first iterator
+      first = simdjson::simdjson_result<ObjIter>(err_type);
+    } else {
+      end = last.value_unsafe();
+    }
+    return SimdObjectIterator(first, end, m_count_items);
+  }
+
+  inline ExpType<std::optional<std::string_view>>
+  SimdObject::read_str_field(const std::string_view key) const {
+    auto str = m_object.find_field_unordered(key).get_string();
+    // rewind, so the fields are iterated from the start
+    if (const auto err_type = m_object.reset().error();
+        err_type != simdjson::SUCCESS) [[unlikely]] {
+      return make_simdjson_error(err_type);
+    }
+    if (str.error() == simdjson::NO_SUCH_FIELD) {
+      return std::nullopt;
+    }
+    return map_simd_data(str);
+  }
+
+} // namespace JsonTypedefCodeGen::Reader::Direct
+
 #endif
@@ -0,0 +1,291 @@
+#pragma once
+
+#if defined(USE_SIMD) && defined(USE_SIMD_DOM)
+
+#include "direct_reader.hpp"
+#include "json_reader.hpp"
+#include "simd.hpp"
+
+namespace JsonTypedefCodeGen::Reader {
+
+  // reader over simdjson's DOM, the whole document is parsed up front. The
+  // values can be read again, copied, and their objects looked up by key.
+  // They point inside the dom::parser, which must outlive them and not parse
+  // another document meanwhile
+  ExpType<JsonValue> simdjson_dom_root_value(
+      const simdjson::simdjson_result<simdjson::dom::element> root);
+
+  // same, but all the reader objects are allocated from the session pool
+  ExpType<JsonValue> simdjson_dom_root_value(
+      const simdjson::simdjson_result<simdjson::dom::element> root,
+      Session& session);
+
+} // namespace JsonTypedefCodeGen::Reader
+
+namespace JsonTypedefCodeGen::Reader::Direct {
+
+  class SimdDomArray;
+  class SimdDomObject;
+
+  class SimdDomValue {
+  private:
+    simdjson::dom::element m_value;
+
+  public:
+    using Array = SimdDomArray;
+    using Object = SimdDomObject;
+
+    SimdDomValue() = delete;
+    SimdDomValue(const simdjson::dom::element val) : m_value(val) {}
+
+    JsonTypes get_type() const;
+
+    ExpType<bool> is_null() const;
+    ExpType<bool> read_bool() const;
+    ExpType<double> read_double() const;
+    ExpType<uint64_t> read_u64() const;
+    ExpType<int64_t> read_i64() const;
+    ExpType<std::string> read_str() const;
+    ExpType<std::string_view> read_str_view() const;
+    ExpType<SimdDomArray> read_array() const;
+    ExpType<SimdDomObject> read_object() const;
+
+    NumberType get_number_type() const;
+  };
+
+  class SimdDomArrayIterator {
+  private:
+    using DomIter = simdjson::dom::array::iterator;
+
+    DomIter m_iter, m_end;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<SimdDomValue>;
+
+    SimdDomArrayIterator() = delete;
+    SimdDomArrayIterator(const DomIter begin, const DomIter end)
+        : m_iter(begin), m_end(end) {}
+
+    inline value_type operator*() const { return SimdDomValue(*m_iter); }
+    inline SimdDomArrayIterator& operator++() {
+      if (m_iter != m_end) {
+        ++m_iter;
+      }
+      return *this;
+    }
+    inline void operator++(int) { ++(*this); }
+
+    inline bool operator==(std::default_sentinel_t) const {
+      return m_iter == m_end;
+    }
+  };
+
+  class SimdDomArray {
+  private:
+    simdjson::dom::array m_array;
+
+  public:
+    using Value = SimdDomValue;
+
+    SimdDomArray() = delete;
+    SimdDomArray(const simdjson::dom::array arr) : m_array(arr) {}
+
+    inline SimdDomArrayIterator begin() const {
+      return SimdDomArrayIterator(m_array.begin(), m_array.end());
+    }
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    // stored in the tape, saturated at 0xFFFFFF items: larger arrays only
+    // reserve that much up front
+    inline std::size_t size_hint() const { return m_array.size(); }
+
+    template <typename NumT>
+      requires std::is_same_v<NumT, double> || std::is_same_v<NumT, int64_t> ||
+               std::is_same_v<NumT, uint64_t>
+    ExpType<void> read_numbers_into(std::vector<NumT>& numbers) const {
+      numbers.reserve(numbers.size() + size_hint());
+      for (const auto item : m_array) {
+        NumT num;
+        if (const auto err_type = item.get(num); err_type != simdjson::SUCCESS)
+            [[unlikely]] {
+          return make_simdjson_error(err_type);
+        }
+        numbers.push_back(num);
+      }
+      return ExpType<void>();
+    }
+  };
+
+  using SimdDomObjectPair = std::pair<std::string_view, SimdDomValue>;
+
+  class SimdDomObjectIterator {
+  private:
+    using DomIter = simdjson::dom::object::iterator;
+
+    DomIter m_iter, m_end;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = ExpType<SimdDomObjectPair>;
+
+    SimdDomObjectIterator() = delete;
+    SimdDomObjectIterator(const DomIter begin, const DomIter end)
+        : m_iter(begin), m_end(end) {}
+
+    inline value_type operator*() const {
+      return SimdDomObjectPair{m_iter.key(), SimdDomValue(m_iter.value())};
+    }
+    inline SimdDomObjectIterator& operator++() {
+      if (m_iter != m_end) {
+        ++m_iter;
+      }
+      return *this;
+    }
+    inline void operator++(int) { ++(*this); }
+
+    inline bool operator==(std::default_sentinel_t) const {
+      return m_iter == m_end;
+    }
+  };
+
+  class SimdDomObject {
+  private:
+    simdjson::dom::object m_object;
+
+  public:
+    using Value = SimdDomValue;
+
+    SimdDomObject() = delete;
+    SimdDomObject(const simdjson::dom::object obj) : m_object(obj) {}
+
+    inline SimdDomObjectIterator begin() const {
+      return SimdDomObjectIterator(m_object.begin(), m_object.end());
+    }
+    inline std::default_sentinel_t end() const {
+      return std::default_sentinel_t{};
+    }
+
+    inline std::size_t size_hint() const { return m_object.size(); }
+
+    // random access, the object isn't consumed
+    ExpType<SimdDomValue> read_field(const std::string_view key) const;
+    ExpType<std::optional<std::string_view>>
+    read_str_field(const std::string_view key) const;
+  };
+
+  inline ExpType<SimdDomValue> simdjson_dom_root_value(
+      const simdjson::simdjson_result<simdjson::dom::element> root) {
+    return map_simd_data(root).transform([](const auto val) {
+      return SimdDomValue(val);
+    });
+  }
+
+  // -------------------------------------------
+  constexpr JsonTypes
+  map_simd_dom_type(const simdjson::dom::element_type type) {
+    using simdjson::dom::element_type;
+    switch (type) {
+    case element_type::ARRAY:
+      return JsonTypes::Array;
+    case element_type::BOOL:
+      return JsonTypes::Bool;
+    case element_type::NULL_VALUE:
+      return JsonTypes::Null;
+    case element_type::INT64:
+    case element_type::UINT64:
+    case element_type::DOUBLE:
+      return JsonTypes::Number;
+    case element_type::OBJECT:
+      return JsonTypes::Object;
+    case element_type::STRING:
+      return JsonTypes::String;
+    default:
+      return JsonTypes::Invalid;
+    }
+  }
+
+  inline JsonTypes SimdDomValue::get_type() const {
+    return map_simd_dom_type(m_value.type());
+  }
+
+  inline ExpType<bool> SimdDomValue::is_null() const {
+    return m_value.is_null();
+  }
+
+  inline ExpType<bool> SimdDomValue::read_bool() const {
+    return map_simd_data(m_value.get_bool());
+  }
+
+  inline ExpType<double> SimdDomValue::read_double() const {
+    return map_simd_data(m_value.get_double());
+  }
+
+  inline ExpType<uint64_t> SimdDomValue::read_u64() const {
+    return map_simd_data(m_value.get_uint64());
+  }
+
+  inline ExpType<int64_t> SimdDomValue::read_i64() const {
+    return map_simd_data(m_value.get_int64());
+  }
+
+  inline ExpType<std::string> SimdDomValue::read_str() const {
+    return map_simd_data(m_value.get_string())
+        .transform([](const std::string_view sv) {
+          return std::string(sv);
+        });
+  }
+
+  inline ExpType<std::string_view> SimdDomValue::read_str_view() const {
+    return map_simd_data(m_value.get_string());
+  }
+
+  inline ExpType<SimdDomArray> SimdDomValue::read_array() const {
+    return map_simd_data(m_value.get_array()).transform([](const auto arr) {
+      return SimdDomArray(arr);
+    });
+  }
+
+  inline ExpType<SimdDomObject> SimdDomValue::read_object() const {
+    return map_simd_data(m_value.get_object()).transform([](const auto obj) {
+      return SimdDomObject(obj);
+    });
+  }
+
+  inline NumberType SimdDomValue::get_number_type() const {
+    using simdjson::dom::element_type;
+    // the tape already holds the parsed number and its kind
+    switch (m_value.type()) {
+    case element_type::DOUBLE:
+      return NumberType::Double;
+    case element_type::INT64:
+      return NumberType::I64;
+    case element_type::UINT64:
+      return NumberType::U64;
+    default:
+      break;
+    }
+    return NumberType::NaN;
+  }
+
+  inline ExpType<SimdDomValue>
+  SimdDomObject::read_field(const std::string_view key) const {
+    return map_simd_data(m_object.at_key(key)).transform([](const auto val) {
+      return SimdDomValue(val);
+    });
+  }
+
+  inline ExpType<std::optional<std::string_view>>
+  SimdDomObject::read_str_field(const std::string_view key) const {
+    auto str = m_object.at_key(key).get_string();
+    if (str.error() == simdjson::NO_SUCH_FIELD) {
+      return std::nullopt;
+    }
+    return map_simd_data(str);
+  }
+
+} // namespace JsonTypedefCodeGen::Reader::Direct
+
+#endif
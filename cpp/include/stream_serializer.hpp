@@ -2,13 +2,36 @@
 
 #include "json_writer.hpp"
 
+#include <functional>
+#include <memory>
 #include <sstream>
 #include <stack>
 
 namespace JsonTypedefCodeGen::Writer {
 
+  // receives the buffered JSON text, each call continues the previous one
+  using StreamSink = std::function<ExpType<void>(const std::string_view)>;
+
+  enum class FloatFormat : uint8_t {
+    // shortest text read back as the same float or double
+    Shortest,
+    // "float_precision" digits after the point, no exponent
+    Fixed
+  };
+
   struct StreamSerializerCreateInfo {
+    // where the JSON goes, only one of them is used. The output stream is
+    // checked first, then the file descriptor, then the sink
     std::ostream* output_stream = nullptr;
+    int output_fd = -1;
+    StreamSink output_sink;
+
+    // the text is written to the output when this buffer is full, when
+    // flushing, and when closing
+    std::size_t buffer_size = 64 * 1024;
+
+    FloatFormat float_format = FloatFormat::Shortest;
+    int float_precision = 6; // clamped to [0, 20]
 
     bool pretty = false;
     bool start_as_array = false;
@@ -25,29 +48,53 @@ namespace JsonTypedefCodeGen::Writer {
       bool last_item_is_a_key;
     };
 
-    std::ostream* m_os = nullptr;
+    StreamSink m_sink;
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_capacity = 0;
+    std::size_t m_used = 0;
+    FloatFormat m_float_format = FloatFormat::Shortest;
+    int m_float_precision = 6;
     std::stack<Status> m_status;
 
     int m_indent = 1;
     std::string m_indent_str;
     bool m_closed = false;
+    // the output failed, what was written is incomplete
+    bool m_sink_failed = false;
     bool m_pretty = false;
     bool m_close_root_item = false;
 
     inline Status& top() { return m_status.top(); }
-    void write_indent();
-    void end_item();
+    ExpType<void> write_sink(const std::string_view text);
+    ExpType<void> write_raw(const std::string_view text);
+    ExpType<void> write_escaped(const std::string_view text);
+    template <typename NumT> ExpType<void> write_number(const NumT num);
+    template <typename FloatT> ExpType<void> write_floating(const FloatT num);
+    ExpType<void> write_indent();
+    ExpType<void> start_key();
+    ExpType<void> end_item();
 
-    StreamSerializer(const StreamSerializerCreateInfo& info);
+    StreamSerializer(const StreamSerializerCreateInfo& info, StreamSink&& sink);
 
   public:
     StreamSerializer() = delete;
+    StreamSerializer(const StreamSerializer&) = delete;
+    StreamSerializer(StreamSerializer&&) = default;
+    // flushes what's left in the buffer, errors are lost
+    ~StreamSerializer();
+
+    StreamSerializer& operator=(const StreamSerializer&) = delete;
+    StreamSerializer& operator=(StreamSerializer&&) = default;
 
-    // to close the root item
+    // to close the root item, and flush
     ExpType<void> close();
+    // writes the buffer to the output. Once the output fails, every write
+    // returns an InOut error
+    ExpType<void> flush();
 
     ExpType<void> write_null();
     ExpType<void> write_bool(const bool b);
+    ExpType<void> write_float(const float f);
     ExpType<void> write_double(const double d);
     ExpType<void> write_i64(const int64_t i);
     ExpType<void> write_u64(const uint64_t u);
@@ -55,11 +102,18 @@ namespace JsonTypedefCodeGen::Writer {
 
     ExpType<void> start_object();
     ExpType<void> write_key(const std::string_view key);
+    // the token is written as it is, in a single copy
+    ExpType<void> write_key_token(const KeyToken& key);
     ExpType<void> end_object();
 
     ExpType<void> start_array();
     ExpType<void> end_array();
 
+    // the data is walked by the serializers' shared code
+    ExpType<void> write(const Data::JsonArray& arr);
+    ExpType<void> write(const Data::JsonObject& obj);
+    ExpType<void> write(const Data::JsonValue& val);
+
     static ExpType<StreamSerializer>
     create(const StreamSerializerCreateInfo& info);
   };
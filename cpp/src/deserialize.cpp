@@ -4,7 +4,6 @@
 #include "deserialize.hpp"
 #include "internal.hpp"
 
-#include <cmath>
 #include <format>
 #include <limits>
 
@@ -24,16 +23,61 @@ namespace JsonTypedefCodeGen::Deserialize {
       return make_json_error(JsonErrorTypes::Invalid, err);
     }
 
-    UnexpJsonError invalid_value(const strview val, const strview name) {
+    DLL_PUBLIC UnexpJsonError disc_not_string(const strview disc) {
+      const auto err = std::format("Expected string value for {}"sv, disc);
+      return make_json_error(JsonErrorTypes::Invalid, err);
+    }
+
+    DLL_PUBLIC UnexpJsonError invalid_value(const strview val,
+                                            const strview name) {
       const auto err = std::format("Invalid value \"{}\" for {}"sv, val, name);
       return make_json_error(JsonErrorTypes::Invalid, err);
     }
 
-    UnexpJsonError missing_key(const strview entry, const strview name) {
+    DLL_PUBLIC UnexpJsonError invalid_key(const strview key,
+                                          const strview name) {
+      const auto err = std::format("Invalid key \"{}\" in {}"sv, key, name);
+      return make_json_error(JsonErrorTypes::Invalid, err);
+    }
+
+    DLL_PUBLIC UnexpJsonError missing_key(const strview entry,
+                                          const strview name) {
       const auto err = std::format("Missing key \"{}\" for {}"sv, entry, name);
       return make_json_error(JsonErrorTypes::String, err);
     }
 
+    DLL_PUBLIC UnexpJsonError signed_limits(const int64_t value,
+                                            const int64_t min,
+                                            const int64_t max) {
+      const auto err = std::format("Signed value {} outside limits {}:{}"sv,
+                                   value, min, max);
+      return make_json_error(JsonErrorTypes::Number, err);
+    }
+
+    DLL_PUBLIC UnexpJsonError unsigned_limits(const uint64_t value,
+                                              const uint64_t max) {
+      const auto err =
+          std::format("Unsigned value {} is greater than {}"sv, value, max);
+      return make_json_error(JsonErrorTypes::Number, err);
+    }
+
+    DLL_PUBLIC UnexpJsonError float_limits(const double value) {
+      constexpr double _min = std::numeric_limits<float>::lowest(),
+                       _max = std::numeric_limits<float>::max();
+      const auto err =
+          std::format("Double value {} outside of float limits {}:{}"sv, value,
+                      _min, _max);
+      return make_json_error(JsonErrorTypes::Number, err);
+    }
+
+    DLL_PUBLIC UnexpJsonError float_zeroes_limits(const double value) {
+      constexpr double _eps = std::numeric_limits<float>::min();
+      const auto err = std::format(
+          "Double value {} outside of float zeroes limits {}:{}"sv, value,
+          -_eps, _eps);
+      return make_json_error(JsonErrorTypes::Number, err);
+    }
+
   } // namespace Errors
 
   DLL_PUBLIC ExpType<int>
@@ -63,21 +107,20 @@ namespace JsonTypedefCodeGen::Deserialize {
     return ExpType<void>();
   }
 
-  DLL_PUBLIC ExpType<std::string> get_disc_value(const Data::JsonObject& object,
-                                                 const strview disc,
-                                                 const strview name) {
+  DLL_PUBLIC ExpType<strview> get_disc_value(const Data::JsonObject& object,
+                                             const strview disc,
+                                             const strview name) {
     auto& inner = object.internal();
 
     if (auto fnd = inner.find(std::string(disc)); fnd == inner.end()) {
       return Errors::missing_key(disc, name);
     } else {
       if (auto opt_str = fnd->second.read_str(); opt_str.has_value()) {
-        return std::string(opt_str.value());
+        return opt_str.value();
       }
     }
 
-    const auto err = std::format("Expected string value for {}"sv, disc);
-    return make_json_error(JsonErrorTypes::Invalid, err);
+    return Errors::disc_not_string(disc);
   }
 
   DLL_PUBLIC ExpType<int>
@@ -89,9 +132,7 @@ namespace JsonTypedefCodeGen::Deserialize {
       }
       ++index;
     }
-
-    const auto err = std::format("Invalid key \"{}\" in {}"sv, value, name);
-    return make_json_error(JsonErrorTypes::Invalid, err);
+    return Errors::invalid_key(value, name);
   }
 
   //  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
@@ -111,61 +152,6 @@ namespace JsonTypedefCodeGen::Deserialize {
                                 "Not a number"sv);
   }
 
-  template <typename NumT>
-  static ExpType<NumT> test_numerical_limits(const ExpType<int64_t> value) {
-    constexpr int64_t _min = std::numeric_limits<NumT>::min(),
-                      _max = std::numeric_limits<NumT>::max();
-    if (value.has_value()) {
-      const auto val = value.value();
-      if (val < _min || val > _max) {
-        return make_json_error(
-            JsonErrorTypes::Number,
-            std::format("Signed value {} outside limits {}:{}"sv, val, _min,
-                        _max));
-      }
-      return ExpType<NumT>((NumT)val);
-    }
-    return UnexpJsonError(std::move(value.error()));
-  }
-
-  template <typename NumT>
-  static ExpType<NumT> test_numerical_limits(const ExpType<uint64_t> value) {
-    constexpr uint64_t _max = std::numeric_limits<NumT>::max();
-    if (value.has_value()) {
-      const auto val = value.value();
-      if (val > _max) {
-        return make_json_error(
-            JsonErrorTypes::Number,
-            std::format("Unsigned value {} is greater than {}"sv, val, _max));
-      }
-      return ExpType<NumT>((NumT)val);
-    }
-    return UnexpJsonError(std::move(value.error()));
-  }
-
-  static ExpType<float> test_numerical_limits(const ExpType<double> value) {
-    constexpr double _min = std::numeric_limits<float>::lowest(),
-                     _max = std::numeric_limits<float>::max(),
-                     _eps = std::numeric_limits<float>::min();
-    if (value.has_value()) {
-      const auto val = value.value();
-      if (val < _min || val > _max) {
-        return make_json_error(
-            JsonErrorTypes::Number,
-            std::format("Double value {} outside of float limits {}:{}"sv, val,
-                        _min, _max));
-      } else if (std::fabs(val) < _eps) {
-        return make_json_error(
-            JsonErrorTypes::Number,
-            std::format(
-                "Double value {} outside of float zeroes limits {}:{}"sv, val,
-                -_eps, _eps));
-      }
-      return ExpType<float>((float)val);
-    }
-    return UnexpJsonError(std::move(value.error()));
-  }
-
   //  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
 
   DLL_PUBLIC ExpType<bool>
@@ -0,0 +1,170 @@
+#include "json_escape.hpp"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JSON_ESCAPE_SSE2
+#include <immintrin.h>
+// the AVX2 variant relies on GCC and Clang's target attribute and builtins
+#if !defined(_MSC_VER)
+#define JSON_ESCAPE_AVX2
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define JSON_ESCAPE_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std::string_view_literals;
+
+namespace JsonTypedefCodeGen::Writer::Specialization {
+
+  namespace {
+
+    constexpr bool needs_escape(const unsigned char c) {
+      return c == '"' || c == '\\' || c < 0x20;
+    }
+
+    std::size_t clean_prefix_scalar(const std::string_view text,
+                                    std::size_t pos) {
+      while (pos < text.size() && !needs_escape(text[pos])) {
+        ++pos;
+      }
+      return pos;
+    }
+
+#if defined(JSON_ESCAPE_SSE2)
+
+    // one bit per byte to escape, unsigned c < 0x20 is max(c, 0x1F) == 0x1F
+    inline uint32_t escape_mask_sse2(const char* data) {
+      const auto chunk = _mm_loadu_si128((const __m128i*)data);
+      const auto quote = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'));
+      const auto bslash = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'));
+      const auto ctrl = _mm_cmpeq_epi8(
+          _mm_max_epu8(chunk, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+      return uint32_t(
+          _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, bslash), ctrl)));
+    }
+
+    std::size_t clean_prefix_sse2(const std::string_view text) {
+      std::size_t pos = 0;
+      for (; pos + 16 <= text.size(); pos += 16) {
+        if (const auto mask = escape_mask_sse2(text.data() + pos); mask != 0) {
+          return pos + std::countr_zero(mask);
+        }
+      }
+      return clean_prefix_scalar(text, pos);
+    }
+
+#if defined(JSON_ESCAPE_AVX2)
+
+    __attribute__((target("avx2"))) std::size_t
+    clean_prefix_avx2(const std::string_view text) {
+      std::size_t pos = 0;
+      const auto quotes = _mm256_set1_epi8('"');
+      const auto bslashes = _mm256_set1_epi8('\\');
+      const auto ctrl_max = _mm256_set1_epi8(0x1F);
+      for (; pos + 32 <= text.size(); pos += 32) {
+        const auto chunk =
+            _mm256_loadu_si256((const __m256i*)(text.data() + pos));
+        const auto quote = _mm256_cmpeq_epi8(chunk, quotes);
+        const auto bslash = _mm256_cmpeq_epi8(chunk, bslashes);
+        const auto ctrl =
+            _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, ctrl_max), ctrl_max);
+        const auto mask = uint32_t(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_or_si256(quote, bslash), ctrl)));
+        if (mask != 0) {
+          return pos + std::countr_zero(mask);
+        }
+      }
+      if (pos + 16 <= text.size()) {
+        if (const auto mask = escape_mask_sse2(text.data() + pos); mask != 0) {
+          return pos + std::countr_zero(mask);
+        }
+        pos += 16;
+      }
+      return clean_prefix_scalar(text, pos);
+    }
+
+    using CleanPrefixFn = std::size_t (*)(const std::string_view);
+
+    // SSE2 is always there on x86-64, AVX2 is checked once
+    CleanPrefixFn select_clean_prefix() {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) {
+        return clean_prefix_avx2;
+      }
+      return clean_prefix_sse2;
+    }
+
+#endif
+
+#elif defined(JSON_ESCAPE_NEON)
+
+    std::size_t clean_prefix_neon(const std::string_view text) {
+      std::size_t pos = 0;
+      const auto quotes = vdupq_n_u8('"');
+      const auto bslashes = vdupq_n_u8('\\');
+      const auto ctrl_end = vdupq_n_u8(0x20);
+      for (; pos + 16 <= text.size(); pos += 16) {
+        const auto chunk = vld1q_u8((const uint8_t*)(text.data() + pos));
+        const auto special =
+            vorrq_u8(vceqq_u8(chunk, quotes), vceqq_u8(chunk, bslashes));
+        const auto found = vorrq_u8(special, vcltq_u8(chunk, ctrl_end));
+        if (vmaxvq_u8(found) != 0) {
+          // the exact byte is found by the scalar loop, within these 16
+          break;
+        }
+      }
+      return clean_prefix_scalar(text, pos);
+    }
+
+#endif
+
+  } // namespace
+
+  std::size_t json_clean_prefix(const std::string_view text) {
+#if defined(JSON_ESCAPE_AVX2)
+    // picked on first use, not by a static initializer
+    static const CleanPrefixFn clean_prefix_impl = select_clean_prefix();
+    return clean_prefix_impl(text);
+#elif defined(JSON_ESCAPE_SSE2)
+    return clean_prefix_sse2(text);
+#elif defined(JSON_ESCAPE_NEON)
+    return clean_prefix_neon(text);
+#else
+    return clean_prefix_scalar(text, 0);
+#endif
+  }
+
+  std::string_view json_escape_char(const char c, char (&tmp)[6]) {
+    switch (c) {
+    case '"':
+      return "\\\""sv;
+    case '\\':
+      return "\\\\"sv;
+    case '\b':
+      return "\\b"sv;
+    case '\f':
+      return "\\f"sv;
+    case '\n':
+      return "\\n"sv;
+    case '\r':
+      return "\\r"sv;
+    case '\t':
+      return "\\t"sv;
+    default:
+      break;
+    }
+    constexpr auto hex = "0123456789abcdef"sv;
+    const auto u = static_cast<unsigned char>(c);
+    tmp[0] = '\\';
+    tmp[1] = 'u';
+    tmp[2] = '0';
+    tmp[3] = '0';
+    tmp[4] = hex[u >> 4];
+    tmp[5] = hex[u & 0xF];
+    return std::string_view(tmp, 6);
+  }
+
+} // namespace JsonTypedefCodeGen::Writer::Specialization
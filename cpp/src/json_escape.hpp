@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// escaping shared by the serializers writing JSON text
+namespace JsonTypedefCodeGen::Writer::Specialization {
+
+  // number of leading characters written as they are, before the first
+  // quote, backslash or control character. Scanned 16 or 32 bytes at a time
+  std::size_t json_clean_prefix(const std::string_view text);
+
+  // the escape sequence of a character json_clean_prefix stopped on, written
+  // in "tmp" when it's a \u00XX sequence
+  std::string_view json_escape_char(const char c, char (&tmp)[6]);
+
+  // calls "write" with the clean runs of "text" and the escape sequences
+  // between them, stops on the first error
+  template <typename Write>
+  auto write_json_escaped(std::string_view text, Write&& write)
+      -> decltype(write(text)) {
+    char tmp[6];
+    while (true) {
+      const auto clean = json_clean_prefix(text);
+      if (clean > 0) {
+        if (auto exp = write(text.substr(0, clean)); !exp.has_value()) {
+          return exp;
+        }
+      }
+      if (clean == text.size()) {
+        return decltype(write(text))();
+      }
+      if (auto exp = write(json_escape_char(text[clean], tmp));
+          !exp.has_value()) {
+        return exp;
+      }
+      text.remove_prefix(clean + 1);
+    }
+  }
+
+} // namespace JsonTypedefCodeGen::Writer::Specialization
@@ -6,6 +6,11 @@
 
 namespace JsonTypedefCodeGen::Reader {
 
+  DLL_PUBLIC Session::Session(std::pmr::memory_resource* upstream)
+      : m_arena(m_buffer.data(), m_buffer.size(), upstream), m_pool(&m_arena) {}
+
+  DLL_PUBLIC Session::~Session() {}
+
   namespace Specialization {
 
     // - - -
@@ -30,6 +35,46 @@ namespace JsonTypedefCodeGen::Reader {
       return JsonArray(std::move(pimpl));
     }
 
+    std::size_t Array::size_hint() const { return 0; }
+
+    template <typename NumT, typename Read>
+    static ExpType<void> read_each_number(const Array& array,
+                                          std::vector<NumT>& numbers,
+                                          Read&& read) {
+      numbers.reserve(numbers.size() + array.size_hint());
+      for (auto iter = array.begin(); iter != std::default_sentinel_t{};
+           ++iter) {
+        const auto item = *iter;
+        if (!item.has_value()) [[unlikely]] {
+          return std::unexpected(item.error());
+        }
+        if (auto num = read(item.value()); num.has_value()) [[likely]] {
+          numbers.push_back(num.value());
+        } else {
+          return std::unexpected(num.error());
+        }
+      }
+      return ExpType<void>();
+    }
+
+    ExpType<void> Array::read_numbers_into(std::vector<double>& numbers) const {
+      return read_each_number(*this, numbers, [](const JsonValue& val) {
+        return val.read_double();
+      });
+    }
+    ExpType<void>
+    Array::read_numbers_into(std::vector<int64_t>& numbers) const {
+      return read_each_number(*this, numbers, [](const JsonValue& val) {
+        return val.read_i64();
+      });
+    }
+    ExpType<void>
+    Array::read_numbers_into(std::vector<uint64_t>& numbers) const {
+      return read_each_number(*this, numbers, [](const JsonValue& val) {
+        return val.read_u64();
+      });
+    }
+
     // - - -
     BaseObject::~BaseObject() {}
     Object::~Object() {}
@@ -37,6 +82,8 @@ namespace JsonTypedefCodeGen::Reader {
       return JsonObject(std::move(pimpl));
     }
 
+    std::size_t Object::size_hint() const { return 0; }
+
     // - - -
     BaseValue::~BaseValue() {}
     Value::~Value() {}
@@ -81,11 +128,12 @@ namespace JsonTypedefCodeGen::Reader {
     };
 
     template <typename Base, typename UnbaseT = Unbase<Base>::type>
-    constexpr const UnbaseT* unbase(const std::unique_ptr<Base>& base) {
+    constexpr const UnbaseT*
+    unbase(const std::unique_ptr<Base, PimplDeleter>& base) {
       return dynamic_cast<const UnbaseT*>(base.get());
     }
     template <typename Base, typename UnbaseT = Unbase<Base>::type>
-    constexpr UnbaseT* unbase(std::unique_ptr<Base>& base) {
+    constexpr UnbaseT* unbase(std::unique_ptr<Base, PimplDeleter>& base) {
       return dynamic_cast<UnbaseT*>(base.get());
     }
 
@@ -131,6 +179,14 @@ namespace JsonTypedefCodeGen::Reader {
     return make_json_error(JsonErrorTypes::Invalid, "end iterator"sv);
   }
 
+  DLL_PUBLIC ExpType<ObjectIteratorViewPair>
+  JsonObjectIterator::view() const {
+    if (m_pimpl) {
+      return Spec::unbase(m_pimpl)->get_view();
+    }
+    return make_json_error(JsonErrorTypes::Invalid, "end iterator"sv);
+  }
+
   DLL_PUBLIC JsonObjectIterator& JsonObjectIterator::operator++() {
     if (m_pimpl) {
       Spec::unbase(m_pimpl)->next();
@@ -143,6 +199,25 @@ namespace JsonTypedefCodeGen::Reader {
     return !m_pimpl || Spec::unbase(m_pimpl)->done();
   }
 
+  DLL_PUBLIC JsonObjectViewIterator::value_type
+  JsonObjectViewIterator::operator*() const {
+    return m_iter.view();
+  }
+
+  DLL_PUBLIC JsonObjectViewIterator& JsonObjectViewIterator::operator++() {
+    ++m_iter;
+    return *this;
+  }
+
+  DLL_PUBLIC bool
+  JsonObjectViewIterator::operator==(std::default_sentinel_t sentinel) const {
+    return m_iter == sentinel;
+  }
+
+  DLL_PUBLIC JsonObjectViewIterator JsonObjectViews::begin() const {
+    return JsonObjectViewIterator(m_object.begin());
+  }
+
   // ------------------------------------------
 
   JsonArray::JsonArray(Spec::ArrayPtr&& pimpl) : m_pimpl(std::move(pimpl)) {}
@@ -151,9 +226,35 @@ namespace JsonTypedefCodeGen::Reader {
     return m_pimpl ? Spec::unbase(m_pimpl)->begin() : JsonArrayIterator();
   }
 
+  static UnexpJsonError no_array_pimpl() {
+    return make_json_error(JsonErrorTypes::Invalid,
+                           "invalid/empty JsonArray"sv);
+  }
+
+  DLL_PUBLIC std::size_t JsonArray::size_hint() const {
+    return m_pimpl ? Spec::unbase(m_pimpl)->size_hint() : 0;
+  }
+
+  DLL_PUBLIC ExpType<void>
+  JsonArray::read_numbers_into(std::vector<double>& numbers) const {
+    return m_pimpl ? Spec::unbase(m_pimpl)->read_numbers_into(numbers)
+                   : no_array_pimpl();
+  }
+  DLL_PUBLIC ExpType<void>
+  JsonArray::read_numbers_into(std::vector<int64_t>& numbers) const {
+    return m_pimpl ? Spec::unbase(m_pimpl)->read_numbers_into(numbers)
+                   : no_array_pimpl();
+  }
+  DLL_PUBLIC ExpType<void>
+  JsonArray::read_numbers_into(std::vector<uint64_t>& numbers) const {
+    return m_pimpl ? Spec::unbase(m_pimpl)->read_numbers_into(numbers)
+                   : no_array_pimpl();
+  }
+
   DLL_PUBLIC ExpType<Data::JsonArray> JsonArray::clone() const {
     Data::JsonArray _result;
     auto& result = _result.internal();
+    result.reserve(size_hint());
     for (const auto& item : *this) {
       if (!item.has_value()) [[unlikely]] {
         return std::unexpected(item.error());
@@ -175,17 +276,30 @@ namespace JsonTypedefCodeGen::Reader {
     return m_pimpl ? Spec::unbase(m_pimpl)->begin() : JsonObjectIterator();
   }
 
+  DLL_PUBLIC std::size_t JsonObject::size_hint() const {
+    return m_pimpl ? Spec::unbase(m_pimpl)->size_hint() : 0;
+  }
+
+  DLL_PUBLIC ExpType<std::optional<std::string_view>>
+  JsonObject::read_str_field(const std::string_view key) const {
+    if (m_pimpl) {
+      return Spec::unbase(m_pimpl)->read_str_field(key);
+    }
+    return make_json_error(JsonErrorTypes::Invalid,
+                           "invalid/empty JsonObject"sv);
+  }
+
   DLL_PUBLIC ExpType<Data::JsonObject> JsonObject::clone() const {
     Data::JsonObject _result;
     auto& result = _result.internal();
-    for (const auto& item : *this) {
+    for (const auto& item : views()) {
       if (!item.has_value()) [[unlikely]] {
         return std::unexpected(item.error());
       }
 
       const auto& [key, val] = item.value();
       if (const auto tmp = val.clone(); tmp.has_value()) [[likely]] {
-        const auto [it, ok] = result.insert({key, tmp.value()});
+        const auto [it, ok] = result.insert({std::string(key), tmp.value()});
         if (!ok) {
           const auto err = format("Duplicated key {}", key);
           return make_json_error(JsonErrorTypes::String, err);
@@ -227,6 +341,9 @@ namespace JsonTypedefCodeGen::Reader {
   DLL_PUBLIC ExpType<std::string> JsonValue::read_str() const {
     return m_pimpl ? Spec::unbase(m_pimpl)->read_str() : no_pimpl();
   }
+  DLL_PUBLIC ExpType<std::string_view> JsonValue::read_str_view() const {
+    return m_pimpl ? Spec::unbase(m_pimpl)->read_str_view() : no_pimpl();
+  }
   DLL_PUBLIC ExpType<JsonArray> JsonValue::read_array() const {
     return m_pimpl ? Spec::unbase(m_pimpl)->read_array() : no_pimpl();
   }
@@ -294,7 +411,7 @@ namespace JsonTypedefCodeGen::Reader {
 
   DLL_PUBLIC ExpType<void> json_object_for_each(const JsonObject& object,
                                                 ObjectForEachFn cb) {
-    for (auto item : object) {
+    for (auto item : object.views()) {
       auto exp = flatten_expected(item.transform([&cb](auto& pair) {
         const auto [key, val] = std::move(pair);
         return cb(key, val);
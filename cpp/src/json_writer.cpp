@@ -2,6 +2,9 @@
 #include "internal.hpp"
 #include "spec_writer.hpp"
 
+#include <charconv>
+#include <cmath>
+
 using namespace std::string_view_literals;
 
 namespace JsonTypedefCodeGen::Writer {
@@ -56,6 +59,23 @@ namespace JsonTypedefCodeGen::Writer {
       return Serializer(std::move(pimpl));
     }
 
+    ExpType<void> AbsSerializer::write_float(const float f) {
+      if (!std::isfinite(f)) {
+        return write_double(f);
+      }
+      // 0.1f is 0.100000001490116 once widened, the double parsed from
+      // its shortest text is printed as 0.1
+      char text[32];
+      const auto [last, ec] = std::to_chars(text, text + sizeof(text), f);
+      double d = f;
+      std::from_chars(text, last, d);
+      return write_double(d);
+    }
+
+    ExpType<void> AbsSerializer::write_key_token(const KeyToken& key) {
+      return write_key(key.key);
+    }
+
     ExpType<ExpType<void>>
     AbsSerializer::write_number(const Data::JsonValue& val) {
       switch (val.get_number_type()) {
@@ -275,6 +295,9 @@ namespace JsonTypedefCodeGen::Writer {
   DLL_PUBLIC ExpType<void> Serializer::write_bool(const bool b) {
     return m_pimpl ? Spec::unbase(m_pimpl)->write_bool(b) : no_pimpl();
   }
+  DLL_PUBLIC ExpType<void> Serializer::write_float(const float f) {
+    return m_pimpl ? Spec::unbase(m_pimpl)->write_float(f) : no_pimpl();
+  }
   DLL_PUBLIC ExpType<void> Serializer::write_double(const double d) {
     return m_pimpl ? Spec::unbase(m_pimpl)->write_double(d) : no_pimpl();
   }
@@ -294,6 +317,9 @@ namespace JsonTypedefCodeGen::Writer {
   DLL_PUBLIC ExpType<void> Serializer::write_key(const std::string_view key) {
     return m_pimpl ? Spec::unbase(m_pimpl)->write_key(key) : no_pimpl();
   }
+  DLL_PUBLIC ExpType<void> Serializer::write_key_token(const KeyToken& key) {
+    return m_pimpl ? Spec::unbase(m_pimpl)->write_key_token(key) : no_pimpl();
+  }
   DLL_PUBLIC ExpType<void> Serializer::end_object() {
     return m_pimpl ? Spec::unbase(m_pimpl)->end_object() : no_pimpl();
   }
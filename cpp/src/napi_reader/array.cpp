@@ -2,35 +2,47 @@
 
 #include "value.hpp"
 
-using namespace std::string_view_literals;
-
 ExpType<JsonValue> NapiArrayIterator::get() const {
-  if (const auto val = m_array.Get(m_index); val.IsEmpty()) {
-    return make_json_error(JsonErrorTypes::Invalid, "Empty value"sv);
-  } else {
-    return NapiValue::create(val);
-  }
+  return (*m_iter).transform([this](const auto val) {
+    return NapiValue::create(val, m_session);
+  });
 }
 
-void NapiArrayIterator::next() {
-  if (!m_array.IsEmpty() && m_index < m_array.Length()) {
-    ++m_index;
-  }
-}
+void NapiArrayIterator::next() { ++m_iter; }
 
 bool NapiArrayIterator::done() const {
-  return m_array.IsEmpty() || m_index == m_array.Length();
+  return m_iter == std::default_sentinel_t{};
 }
 
-JsonArrayIterator NapiArrayIterator::create(const Napi::Array arr) {
-  return create_json(std::move(std::make_unique<NapiArrayIterator>(arr)));
+JsonArrayIterator
+NapiArrayIterator::create(const Direct::NapiArrayIterator iter,
+                          Session* session) {
+  return create_json(
+      Specialization::make_pimpl<NapiArrayIterator>(session, iter, session));
 }
 
 // -------------------------------------------
 JsonArrayIterator NapiArray::begin() const {
-  return NapiArrayIterator::create(m_array);
+  return NapiArrayIterator::create(m_array.begin(), m_session);
+}
+
+std::size_t NapiArray::size_hint() const { return m_array.size_hint(); }
+
+ExpType<void> NapiArray::read_numbers_into(std::vector<double>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+ExpType<void>
+NapiArray::read_numbers_into(std::vector<int64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+ExpType<void>
+NapiArray::read_numbers_into(std::vector<uint64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
 }
 
-JsonArray NapiArray::create(const Napi::Array arr) {
-  return create_json(std::move(std::make_unique<NapiArray>(arr)));
+JsonArray NapiArray::create(const Direct::NapiArray arr, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<NapiArray>(session, arr, session));
 }
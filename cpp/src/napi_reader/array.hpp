@@ -2,37 +2,49 @@
 
 #include "../spec_reader.hpp"
 
-#include <napi.h>
+#include "napi.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
 class NapiArrayIterator : public Specialization::ArrayIterator {
 private:
-  Napi::Array m_array;
-  uint32_t m_index = 0;
+  Direct::NapiArrayIterator m_iter;
+  Session* m_session;
 
 public:
   NapiArrayIterator() = delete;
-  NapiArrayIterator(const Napi::Array arr) : m_array(arr) {}
+  NapiArrayIterator(const Direct::NapiArrayIterator iter, Session* session)
+      : m_iter(iter), m_session(session) {}
 
   virtual ExpType<JsonValue> get() const override;
   virtual void next() override;
   virtual bool done() const override;
 
-  static JsonArrayIterator create(const Napi::Array arr);
+  static JsonArrayIterator create(const Direct::NapiArrayIterator iter,
+                                  Session* session);
 };
 
 class NapiArray : public Specialization::Array {
 private:
-  Napi::Array m_array;
+  Direct::NapiArray m_array;
+  Session* m_session;
 
 public:
   NapiArray() = delete;
-  NapiArray(const Napi::Array arr) : m_array(arr) {}
+  NapiArray(const Direct::NapiArray arr, Session* session)
+      : m_array(arr), m_session(session) {}
   ~NapiArray() {}
 
   virtual JsonArrayIterator begin() const override;
+  virtual std::size_t size_hint() const override;
 
-  static JsonArray create(const Napi::Array arr);
+  virtual ExpType<void>
+  read_numbers_into(std::vector<double>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<int64_t>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<uint64_t>& numbers) const override;
+
+  static JsonArray create(const Direct::NapiArray arr, Session* session);
 };
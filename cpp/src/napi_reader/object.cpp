@@ -2,54 +2,55 @@
 
 #include "value.hpp"
 
-using namespace std::string_view_literals;
-
-NapiObjectIterator::NapiObjectIterator(Napi::Object object) : m_object(object) {
-  auto maybe = object.GetPropertyNames();
-  if (maybe.IsArray()) {
-    m_keys = maybe.As<Napi::Array>();
-  }
-}
-
 ExpType<ObjectIteratorPair> NapiObjectIterator::get() const {
-  if (m_keys.IsEmpty()) {
-    return make_json_error(JsonErrorTypes::Invalid, "Object with no keys"sv);
-  }
-
-  const auto key = m_keys.Get(m_index);
-  if (key.IsEmpty()) {
-    return make_json_error(JsonErrorTypes::Invalid, "Empty key"sv);
-  } else if (!key.IsString() && !key.IsSymbol()) {
-    return make_json_error(JsonErrorTypes::WrongType,
-                           "Object's key is not a string"sv);
-  }
-
-  const auto val = m_object.Get(key);
-  if (val.IsEmpty()) {
-    return make_json_error(JsonErrorTypes::Invalid, "Empty value"sv);
-  }
-  return ObjectIteratorPair(key.ToString(), NapiValue::create(val));
+  return (*m_iter).transform([this](const auto& pair) {
+    return ObjectIteratorPair{pair.first,
+                              NapiValue::create(pair.second, m_session)};
+  });
 }
 
-void NapiObjectIterator::next() {
-  if (!m_keys.IsEmpty() && m_index < m_keys.Length()) {
-    ++m_index;
-  }
+ExpType<ObjectIteratorViewPair> NapiObjectIterator::get_view() const {
+  return (*m_iter).transform([this](auto pair) {
+    m_key = std::move(pair.first);
+    return ObjectIteratorViewPair{m_key,
+                                  NapiValue::create(pair.second, m_session)};
+  });
 }
 
+void NapiObjectIterator::next() { ++m_iter; }
+
 bool NapiObjectIterator::done() const {
-  return m_keys.IsEmpty() || m_index == m_keys.Length();
+  return m_iter == std::default_sentinel_t{};
 }
 
-JsonObjectIterator NapiObjectIterator::create(Napi::Object object) {
-  return create_json(std::move(std::make_unique<NapiObjectIterator>(object)));
+JsonObjectIterator
+NapiObjectIterator::create(const Direct::NapiObjectIterator iter,
+                           Session* session) {
+  return create_json(
+      Specialization::make_pimpl<NapiObjectIterator>(session, iter, session));
 }
 
 // -------------------------------------------
 JsonObjectIterator NapiObject::begin() const {
-  return NapiObjectIterator::create(m_object);
+  return NapiObjectIterator::create(m_object.begin(), m_session);
+}
+
+std::size_t NapiObject::size_hint() const { return m_object.size_hint(); }
+
+ExpType<std::optional<std::string_view>>
+NapiObject::read_str_field(const std::string_view key) const {
+  if (!m_object.has_field(key)) {
+    return std::nullopt;
+  }
+  return m_object.read_field(key)
+      .and_then([](const auto val) { return val.read_str(); })
+      .transform([this](std::string str) {
+        m_str = std::move(str);
+        return std::optional<std::string_view>(m_str);
+      });
 }
 
-JsonObject NapiObject::create(const Napi::Object arr) {
-  return create_json(std::move(std::make_unique<NapiObject>(arr)));
+JsonObject NapiObject::create(const Direct::NapiObject obj, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<NapiObject>(session, obj, session));
 }
@@ -2,38 +2,49 @@
 
 #include "../spec_reader.hpp"
 
-#include <napi.h>
+#include "napi.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
 class NapiObjectIterator : public Specialization::ObjectIterator {
 private:
-  Napi::Object m_object;
-  Napi::Array m_keys;
-  uint32_t m_index = 0;
+  Direct::NapiObjectIterator m_iter;
+  Session* m_session;
+  // N-API keys are converted to UTF-8, kept for get_view
+  mutable std::string m_key;
 
 public:
   NapiObjectIterator() = delete;
-  NapiObjectIterator(Napi::Object object);
+  NapiObjectIterator(const Direct::NapiObjectIterator iter, Session* session)
+      : m_iter(iter), m_session(session) {}
 
   virtual ExpType<ObjectIteratorPair> get() const override;
+  virtual ExpType<ObjectIteratorViewPair> get_view() const override;
   virtual void next() override;
   virtual bool done() const override;
 
-  static JsonObjectIterator create(Napi::Object object);
+  static JsonObjectIterator create(const Direct::NapiObjectIterator iter,
+                                   Session* session);
 };
 
 class NapiObject : public Specialization::Object {
 private:
-  Napi::Object m_object;
+  Direct::NapiObject m_object;
+  Session* m_session;
+  // N-API strings are converted to UTF-8, kept for read_str_field
+  mutable std::string m_str;
 
 public:
   NapiObject() = delete;
-  NapiObject(const Napi::Object obj) : m_object(obj) {}
+  NapiObject(const Direct::NapiObject obj, Session* session)
+      : m_object(obj), m_session(session) {}
   ~NapiObject() {}
 
   virtual JsonObjectIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+  virtual ExpType<std::optional<std::string_view>>
+  read_str_field(const std::string_view key) const override;
 
-  static JsonObject create(const Napi::Object obj);
+  static JsonObject create(const Direct::NapiObject obj, Session* session);
 };
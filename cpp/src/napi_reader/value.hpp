@@ -2,18 +2,23 @@
 
 #include "../spec_reader.hpp"
 
-#include <napi.h>
+#include "napi.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
+// type erased wrapper around the compile-time reader "Direct::NapiValue"
 class NapiValue : public Specialization::Value {
 private:
-  Napi::Value m_value;
+  Direct::NapiValue m_value;
+  Session* m_session;
+  // N-API strings are converted to UTF-8, kept for read_str_view
+  mutable std::string m_str;
 
 public:
   NapiValue() = delete;
-  NapiValue(const Napi::Value val) : m_value(val) {}
+  NapiValue(const Direct::NapiValue val, Session* session)
+      : m_value(val), m_session(session) {}
   ~NapiValue() {}
 
   virtual JsonTypes get_type() const override;
@@ -24,15 +29,14 @@ public:
   virtual ExpType<uint64_t> read_u64() const override;
   virtual ExpType<int64_t> read_i64() const override;
   virtual ExpType<std::string> read_str() const override;
+  virtual ExpType<std::string_view> read_str_view() const override;
   virtual ExpType<JsonArray> read_array() const override;
   virtual ExpType<JsonObject> read_object() const override;
 
   virtual NumberType get_number_type() const override;
 
-  static JsonValue create(const Napi::Value val);
+  static JsonValue create(const Direct::NapiValue val, Session* session);
 };
 
-// -------------------------------------------
-
 // -------------------------------------------
 UnexpJsonError make_json_error(const napi_status err_type);
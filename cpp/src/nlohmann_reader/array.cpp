@@ -3,29 +3,46 @@
 #include "value.hpp"
 
 ExpType<JsonValue> NlohArrayIterator::get() const {
-  return NlohValue::create(*m_iter);
+  return (*m_iter).transform([this](const auto val) {
+    return NlohValue::create(val, m_session);
+  });
 }
 
-void NlohArrayIterator::next() {
-  if (m_iter != m_end) {
-    ++m_iter;
-  }
-}
+void NlohArrayIterator::next() { ++m_iter; }
 
-bool NlohArrayIterator::done() const { return m_iter == m_end; }
+bool NlohArrayIterator::done() const {
+  return m_iter == std::default_sentinel_t{};
+}
 
-JsonArrayIterator NlohArrayIterator::create(NlohVectorIter begin,
-                                            NlohVectorIter end) {
+JsonArrayIterator
+NlohArrayIterator::create(const Direct::NlohArrayIterator iter,
+                          Session* session) {
   return create_json(
-      std::move(std::make_unique<NlohArrayIterator>(begin, end)));
+      Specialization::make_pimpl<NlohArrayIterator>(session, iter, session));
 }
 
 // -------------------------------------------
 JsonArrayIterator NlohArray::begin() const {
-  auto first = m_array.begin(), last = m_array.end();
-  return NlohArrayIterator::create(first, last);
+  return NlohArrayIterator::create(m_array.begin(), m_session);
+}
+
+std::size_t NlohArray::size_hint() const { return m_array.size_hint(); }
+
+ExpType<void> NlohArray::read_numbers_into(std::vector<double>& numbers) const {
+  return m_array.read_numbers_into(numbers);
 }
 
-JsonArray NlohArray::create(const NlohArray arr) {
-  return create_json(std::move(std::make_unique<NlohArray>(arr)));
+ExpType<void>
+NlohArray::read_numbers_into(std::vector<int64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+ExpType<void>
+NlohArray::read_numbers_into(std::vector<uint64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+JsonArray NlohArray::create(const Direct::NlohArray arr, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<NlohArray>(session, arr, session));
 }
@@ -1,40 +1,50 @@
 #pragma once
 
 #include "../spec_reader.hpp"
-#include "nlohmann/json.hpp"
+
+#include "nlohmann.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
-using NlohVector = nlohmann::json::array_t;
-using NlohVectorIter = NlohVector::iterator;
-
 class NlohArrayIterator final : public Specialization::ArrayIterator {
 private:
-  NlohVectorIter m_iter, m_end;
+  Direct::NlohArrayIterator m_iter;
+  Session* m_session;
 
 public:
   NlohArrayIterator() = delete;
-  NlohArrayIterator(NlohVectorIter begin, NlohVectorIter end)
-      : m_iter(begin), m_end(end) {}
+  NlohArrayIterator(const Direct::NlohArrayIterator iter, Session* session)
+      : m_iter(iter), m_session(session) {}
 
   virtual ExpType<JsonValue> get() const override;
   virtual void next() override;
   virtual bool done() const override;
 
-  static JsonArrayIterator create(NlohVectorIter begin, NlohVectorIter end);
+  static JsonArrayIterator create(const Direct::NlohArrayIterator iter,
+                                  Session* session);
 };
 
 class NlohArray final : public Specialization::Array {
 private:
-  mutable NlohVector m_array;
+  Direct::NlohArray m_array;
+  Session* m_session;
 
 public:
   NlohArray() = delete;
-  NlohArray(const NlohVector arr) : m_array(arr) {}
+  NlohArray(const Direct::NlohArray arr, Session* session)
+      : m_array(arr), m_session(session) {}
   ~NlohArray() {}
 
   virtual JsonArrayIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+
+  virtual ExpType<void>
+  read_numbers_into(std::vector<double>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<int64_t>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<uint64_t>& numbers) const override;
 
-  static JsonArray create(const NlohArray arr);
+  static JsonArray create(const Direct::NlohArray arr, Session* session);
 };
@@ -3,29 +3,45 @@
 #include "value.hpp"
 
 ExpType<ObjectIteratorPair> NlohObjectIterator::get() const {
-  return ObjectIteratorPair{m_iter->first, NlohValue::create(m_iter->second)};
+  return (*m_iter).transform([this](const auto& pair) {
+    return ObjectIteratorPair{std::string(pair.first),
+                              NlohValue::create(pair.second, m_session)};
+  });
 }
 
-void NlohObjectIterator::next() {
-  if (m_iter != m_end) {
-    ++m_iter;
-  }
+ExpType<ObjectIteratorViewPair> NlohObjectIterator::get_view() const {
+  return (*m_iter).transform([this](const auto& pair) {
+    return ObjectIteratorViewPair{pair.first,
+                                  NlohValue::create(pair.second, m_session)};
+  });
 }
 
-bool NlohObjectIterator::done() const { return m_iter == m_end; }
+void NlohObjectIterator::next() { ++m_iter; }
 
-JsonObjectIterator NlohObjectIterator::create(NlohMapIter begin,
-                                              NlohMapIter end) {
+bool NlohObjectIterator::done() const {
+  return m_iter == std::default_sentinel_t{};
+}
+
+JsonObjectIterator
+NlohObjectIterator::create(const Direct::NlohObjectIterator iter,
+                           Session* session) {
   return create_json(
-      std::move(std::make_unique<NlohObjectIterator>(begin, end)));
+      Specialization::make_pimpl<NlohObjectIterator>(session, iter, session));
 }
 
 // -------------------------------------------
 JsonObjectIterator NlohObject::begin() const {
-  auto first = m_object.begin(), last = m_object.end();
-  return NlohObjectIterator::create(first, last);
+  return NlohObjectIterator::create(m_object.begin(), m_session);
+}
+
+std::size_t NlohObject::size_hint() const { return m_object.size_hint(); }
+
+ExpType<std::optional<std::string_view>>
+NlohObject::read_str_field(const std::string_view key) const {
+  return m_object.read_str_field(key);
 }
 
-JsonObject NlohObject::create(const NlohMap obj) {
-  return create_json(std::move(std::make_unique<NlohObject>(obj)));
+JsonObject NlohObject::create(const Direct::NlohObject obj, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<NlohObject>(session, obj, session));
 }
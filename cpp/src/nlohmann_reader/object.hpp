@@ -1,40 +1,46 @@
 #pragma once
 
 #include "../spec_reader.hpp"
-#include "nlohmann/json.hpp"
+
+#include "nlohmann.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
-using NlohMap = nlohmann::json::object_t;
-using NlohMapIter = NlohMap::iterator;
-
 class NlohObjectIterator final : public Specialization::ObjectIterator {
 private:
-  NlohMapIter m_iter, m_end;
+  Direct::NlohObjectIterator m_iter;
+  Session* m_session;
 
 public:
   NlohObjectIterator() = delete;
-  NlohObjectIterator(NlohMapIter begin, NlohMapIter end)
-      : m_iter(begin), m_end(end) {}
+  NlohObjectIterator(const Direct::NlohObjectIterator iter, Session* session)
+      : m_iter(iter), m_session(session) {}
 
   virtual ExpType<ObjectIteratorPair> get() const override;
+  virtual ExpType<ObjectIteratorViewPair> get_view() const override;
   virtual void next() override;
   virtual bool done() const override;
 
-  static JsonObjectIterator create(NlohMapIter begin, NlohMapIter end);
+  static JsonObjectIterator create(const Direct::NlohObjectIterator iter,
+                                   Session* session);
 };
 
 class NlohObject final : public Specialization::Object {
 private:
-  mutable NlohMap m_object;
+  Direct::NlohObject m_object;
+  Session* m_session;
 
 public:
   NlohObject() = delete;
-  NlohObject(const NlohMap obj) : m_object(obj) {}
+  NlohObject(const Direct::NlohObject obj, Session* session)
+      : m_object(obj), m_session(session) {}
   ~NlohObject() {}
 
   virtual JsonObjectIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+  virtual ExpType<std::optional<std::string_view>>
+  read_str_field(const std::string_view key) const override;
 
-  static JsonObject create(const NlohMap obj);
+  static JsonObject create(const Direct::NlohObject obj, Session* session);
 };
@@ -1,21 +1,24 @@
 #pragma once
 
 #include "../spec_reader.hpp"
-#include "nlohmann/json.hpp"
 
-// PROBABLY BETA VERSION
-// doing a lot of copies for array and object
+#include "nlohmann.hpp"
+
+// the values, arrays and objects point inside the caller's document, which
+// must outlive them
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
 class NlohValue final : public Specialization::Value {
 private:
-  mutable nlohmann::json m_value;
+  Direct::NlohValue m_value;
+  Session* m_session;
 
 public:
   NlohValue() = delete;
-  NlohValue(const nlohmann::json value) : m_value(value) {}
+  NlohValue(const Direct::NlohValue value, Session* session)
+      : m_value(value), m_session(session) {}
   ~NlohValue() {}
 
   virtual JsonTypes get_type() const override;
@@ -26,12 +29,11 @@ public:
   virtual ExpType<uint64_t> read_u64() const override;
   virtual ExpType<int64_t> read_i64() const override;
   virtual ExpType<std::string> read_str() const override;
+  virtual ExpType<std::string_view> read_str_view() const override;
   virtual ExpType<JsonArray> read_array() const override;
   virtual ExpType<JsonObject> read_object() const override;
 
   virtual NumberType get_number_type() const override;
 
-  static JsonValue create(const nlohmann::json val);
+  static JsonValue create(const Direct::NlohValue value, Session* session);
 };
-
-// -------------------------------------------
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "array.hpp"
+
+#include "value.hpp"
+
+ExpType<JsonValue> SimdDomArrayIterator::get() const {
+  return (*m_iter).transform([this](const auto val) {
+    return SimdDomValue::create(val, m_session);
+  });
+}
+
+void SimdDomArrayIterator::next() { ++m_iter; }
+
+bool SimdDomArrayIterator::done() const {
+  return m_iter == std::default_sentinel_t{};
+}
+
+JsonArrayIterator
+SimdDomArrayIterator::create(const Direct::SimdDomArrayIterator iter,
+                             Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdDomArrayIterator>(session, iter, session));
+}
+
+// -------------------------------------------
+JsonArrayIterator SimdDomArray::begin() const {
+  return SimdDomArrayIterator::create(m_array.begin(), m_session);
+}
+
+std::size_t SimdDomArray::size_hint() const { return m_array.size_hint(); }
+
+ExpType<void>
+SimdDomArray::read_numbers_into(std::vector<double>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+ExpType<void>
+SimdDomArray::read_numbers_into(std::vector<int64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+ExpType<void>
+SimdDomArray::read_numbers_into(std::vector<uint64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+JsonArray SimdDomArray::create(const Direct::SimdDomArray arr,
+                               Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdDomArray>(session, arr, session));
+}
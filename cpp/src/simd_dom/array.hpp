@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../spec_reader.hpp"
+
+#include "simd_dom.hpp"
+
+using namespace JsonTypedefCodeGen;
+using namespace JsonTypedefCodeGen::Reader;
+
+class SimdDomArrayIterator final : public Specialization::ArrayIterator {
+private:
+  Direct::SimdDomArrayIterator m_iter;
+  Session* m_session;
+
+public:
+  SimdDomArrayIterator() = delete;
+  SimdDomArrayIterator(const Direct::SimdDomArrayIterator iter,
+                       Session* session)
+      : m_iter(iter), m_session(session) {}
+
+  virtual ExpType<JsonValue> get() const override;
+  virtual void next() override;
+  virtual bool done() const override;
+
+  static JsonArrayIterator create(const Direct::SimdDomArrayIterator iter,
+                                  Session* session);
+};
+
+class SimdDomArray final : public Specialization::Array {
+private:
+  Direct::SimdDomArray m_array;
+  Session* m_session;
+
+public:
+  SimdDomArray() = delete;
+  SimdDomArray(const Direct::SimdDomArray arr, Session* session)
+      : m_array(arr), m_session(session) {}
+  ~SimdDomArray() {}
+
+  virtual JsonArrayIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+
+  virtual ExpType<void>
+  read_numbers_into(std::vector<double>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<int64_t>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<uint64_t>& numbers) const override;
+
+  static JsonArray create(const Direct::SimdDomArray arr, Session* session);
+};
@@ -0,0 +1,48 @@
+#include "object.hpp"
+
+#include "value.hpp"
+
+ExpType<ObjectIteratorPair> SimdDomObjectIterator::get() const {
+  return get_view().transform([](auto pair) {
+    return ObjectIteratorPair{std::string(pair.first), std::move(pair.second)};
+  });
+}
+
+ExpType<ObjectIteratorViewPair> SimdDomObjectIterator::get_view() const {
+  return (*m_iter).transform([this](const auto& pair) {
+    return ObjectIteratorViewPair{pair.first,
+                                  SimdDomValue::create(pair.second, m_session)};
+  });
+}
+
+void SimdDomObjectIterator::next() { ++m_iter; }
+
+bool SimdDomObjectIterator::done() const {
+  return m_iter == std::default_sentinel_t{};
+}
+
+JsonObjectIterator
+SimdDomObjectIterator::create(const Direct::SimdDomObjectIterator iter,
+                              Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdDomObjectIterator>(session, iter,
+                                                        session));
+}
+
+// -------------------------------------------
+JsonObjectIterator SimdDomObject::begin() const {
+  return SimdDomObjectIterator::create(m_object.begin(), m_session);
+}
+
+std::size_t SimdDomObject::size_hint() const { return m_object.size_hint(); }
+
+ExpType<std::optional<std::string_view>>
+SimdDomObject::read_str_field(const std::string_view key) const {
+  return m_object.read_str_field(key);
+}
+
+JsonObject SimdDomObject::create(const Direct::SimdDomObject obj,
+                                 Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdDomObject>(session, obj, session));
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../spec_reader.hpp"
+
+#include "simd_dom.hpp"
+
+using namespace JsonTypedefCodeGen;
+using namespace JsonTypedefCodeGen::Reader;
+
+class SimdDomObjectIterator final : public Specialization::ObjectIterator {
+private:
+  Direct::SimdDomObjectIterator m_iter;
+  Session* m_session;
+
+public:
+  SimdDomObjectIterator() = delete;
+  SimdDomObjectIterator(const Direct::SimdDomObjectIterator iter,
+                        Session* session)
+      : m_iter(iter), m_session(session) {}
+
+  virtual ExpType<ObjectIteratorPair> get() const override;
+  virtual ExpType<ObjectIteratorViewPair> get_view() const override;
+  virtual void next() override;
+  virtual bool done() const override;
+
+  static JsonObjectIterator create(const Direct::SimdDomObjectIterator iter,
+                                   Session* session);
+};
+
+class SimdDomObject final : public Specialization::Object {
+private:
+  Direct::SimdDomObject m_object;
+  Session* m_session;
+
+public:
+  SimdDomObject() = delete;
+  SimdDomObject(const Direct::SimdDomObject obj, Session* session)
+      : m_object(obj), m_session(session) {}
+  ~SimdDomObject() {}
+
+  virtual JsonObjectIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+  virtual ExpType<std::optional<std::string_view>>
+  read_str_field(const std::string_view key) const override;
+
+  static JsonObject create(const Direct::SimdDomObject obj, Session* session);
+};
@@ -0,0 +1,74 @@
+#include "value.hpp"
+
+#include "../internal.hpp"
+#include "array.hpp"
+#include "object.hpp"
+
+// -------------------------------------------
+JsonTypes SimdDomValue::get_type() const { return m_value.get_type(); }
+
+ExpType<bool> SimdDomValue::is_null() const { return m_value.is_null(); }
+
+ExpType<bool> SimdDomValue::read_bool() const { return m_value.read_bool(); }
+
+ExpType<double> SimdDomValue::read_double() const {
+  return m_value.read_double();
+}
+
+ExpType<uint64_t> SimdDomValue::read_u64() const { return m_value.read_u64(); }
+
+ExpType<int64_t> SimdDomValue::read_i64() const { return m_value.read_i64(); }
+
+ExpType<std::string> SimdDomValue::read_str() const {
+  return m_value.read_str();
+}
+
+ExpType<std::string_view> SimdDomValue::read_str_view() const {
+  return m_value.read_str_view();
+}
+
+ExpType<JsonArray> SimdDomValue::read_array() const {
+  return m_value.read_array().transform([this](const auto arr) {
+    return SimdDomArray::create(arr, m_session);
+  });
+}
+
+ExpType<JsonObject> SimdDomValue::read_object() const {
+  return m_value.read_object().transform([this](const auto obj) {
+    return SimdDomObject::create(obj, m_session);
+  });
+}
+
+NumberType SimdDomValue::get_number_type() const {
+  return m_value.get_number_type();
+}
+
+JsonValue SimdDomValue::create(const Direct::SimdDomValue val,
+                               Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdDomValue>(session, val, session));
+}
+
+// -------------------------------------------
+// -------------------------------------------
+namespace JsonTypedefCodeGen::Reader {
+
+  using namespace simdjson;
+
+  DLL_PUBLIC ExpType<JsonValue>
+  simdjson_dom_root_value(const simdjson_result<dom::element> root) {
+    return Direct::simdjson_dom_root_value(root).transform([](const auto val) {
+      return SimdDomValue::create(val, nullptr);
+    });
+  }
+
+  DLL_PUBLIC ExpType<JsonValue>
+  simdjson_dom_root_value(const simdjson_result<dom::element> root,
+                          Session& session) {
+    return Direct::simdjson_dom_root_value(root).transform(
+        [&session](auto val) {
+          return SimdDomValue::create(val, &session);
+        });
+  }
+
+} // namespace JsonTypedefCodeGen::Reader
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../spec_reader.hpp"
+
+#include "simd_dom.hpp"
+
+using namespace JsonTypedefCodeGen;
+using namespace JsonTypedefCodeGen::Reader;
+
+// type erased wrapper around the compile-time reader "Direct::SimdDomValue"
+class SimdDomValue final : public Specialization::Value {
+private:
+  Direct::SimdDomValue m_value;
+  Session* m_session;
+
+public:
+  SimdDomValue() = delete;
+  SimdDomValue(const Direct::SimdDomValue val, Session* session)
+      : m_value(val), m_session(session) {}
+  ~SimdDomValue() {}
+
+  virtual JsonTypes get_type() const override;
+
+  virtual ExpType<bool> is_null() const override;
+  virtual ExpType<bool> read_bool() const override;
+  virtual ExpType<double> read_double() const override;
+  virtual ExpType<uint64_t> read_u64() const override;
+  virtual ExpType<int64_t> read_i64() const override;
+  virtual ExpType<std::string> read_str() const override;
+  virtual ExpType<std::string_view> read_str_view() const override;
+  virtual ExpType<JsonArray> read_array() const override;
+  virtual ExpType<JsonObject> read_object() const override;
+
+  virtual NumberType get_number_type() const override;
+
+  static JsonValue create(const Direct::SimdDomValue val, Session* session);
+};
@@ -3,51 +3,46 @@
 #include "value.hpp"
 
 ExpType<JsonValue> SimdArrayIterator::get() const {
-  auto err_type = m_iter.error();
-  if (err_type == simdjson::SUCCESS) {
-    auto unsafe_val = m_iter.value_unsafe();
-    auto val = *unsafe_val;
-    err_type = val.error();
-    if (err_type == simdjson::SUCCESS) {
-      return SimdValue::create(val.value_unsafe());
-    }
-  }
-  return make_json_error(err_type);
-}
-
-void SimdArrayIterator::next() {
-  if (m_iter.error() == simdjson::SUCCESS) {
-    if (m_iter.value_unsafe() == m_end) {
-      // if it reached the end, invalidate it
-      m_iter = ArrIterResult(simdjson::OUT_OF_BOUNDS);
-    } else {
-      ++(m_iter.value_unsafe());
-    }
-  }
+  return (*m_iter).transform([this](const auto val) {
+    return SimdValue::create(val, m_session);
+  });
 }
 
+void SimdArrayIterator::next() { ++m_iter; }
+
 bool SimdArrayIterator::done() const {
-  return m_iter.error() != simdjson::SUCCESS || m_iter.value_unsafe() == m_end;
+  return m_iter == std::default_sentinel_t{};
 }
 
-JsonArrayIterator SimdArrayIterator::create(ArrIterResult begin, ArrIter end) {
+JsonArrayIterator
+SimdArrayIterator::create(const Direct::SimdArrayIterator iter,
+                          Session* session) {
   return create_json(
-      std::move(std::make_unique<SimdArrayIterator>(begin, end)));
+      Specialization::make_pimpl<SimdArrayIterator>(session, iter, session));
 }
 
 // -------------------------------------------
 JsonArrayIterator SimdArray::begin() const {
-  auto first = m_array.begin(), last = m_array.end();
-  ArrIter end; // default and invalid, never used if there's an error
+  return SimdArrayIterator::create(m_array.begin(), m_session);
+}
+
+std::size_t SimdArray::size_hint() const { return m_array.size_hint(); }
+
+ExpType<void> SimdArray::read_numbers_into(std::vector<double>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
+
+ExpType<void>
+SimdArray::read_numbers_into(std::vector<int64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
+}
 
-  if (const auto err_type = last.error(); err_type != simdjson::SUCCESS) {
-    first = ArrIterResult(err_type); // forward the error on the first iterator
-  } else {
-    end = last.value_unsafe();
-  }
-  return SimdArrayIterator::create(first, end);
+ExpType<void>
+SimdArray::read_numbers_into(std::vector<uint64_t>& numbers) const {
+  return m_array.read_numbers_into(numbers);
 }
 
-JsonArray SimdArray::create(const simdjson::ondemand::array arr) {
-  return create_json(std::move(std::make_unique<SimdArray>(arr)));
+JsonArray SimdArray::create(const Direct::SimdArray arr, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdArray>(session, arr, session));
 }
@@ -2,41 +2,49 @@
 
 #include "../spec_reader.hpp"
 
-#include "simdjson.h"
+#include "simd.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
-using ArrIter = simdjson::ondemand::array_iterator;
-using ArrIterResult = simdjson::simdjson_result<ArrIter>;
-
 class SimdArrayIterator final : public Specialization::ArrayIterator {
 private:
-  ArrIterResult m_iter;
-  ArrIter m_end;
+  Direct::SimdArrayIterator m_iter;
+  Session* m_session;
 
 public:
   SimdArrayIterator() = delete;
-  SimdArrayIterator(const ArrIterResult begin, ArrIter end)
-      : m_iter(begin), m_end(end) {}
+  SimdArrayIterator(const Direct::SimdArrayIterator iter, Session* session)
+      : m_iter(iter), m_session(session) {}
 
   virtual ExpType<JsonValue> get() const override;
   virtual void next() override;
   virtual bool done() const override;
 
-  static JsonArrayIterator create(ArrIterResult begin, ArrIter end);
+  static JsonArrayIterator create(const Direct::SimdArrayIterator iter,
+                                  Session* session);
 };
 
 class SimdArray final : public Specialization::Array {
 private:
-  mutable simdjson::ondemand::array m_array;
+  Direct::SimdArray m_array;
+  Session* m_session;
 
 public:
   SimdArray() = delete;
-  SimdArray(const simdjson::ondemand::array arr) : m_array(arr) {}
+  SimdArray(const Direct::SimdArray arr, Session* session)
+      : m_array(arr), m_session(session) {}
   ~SimdArray() {}
 
   virtual JsonArrayIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+
+  virtual ExpType<void>
+  read_numbers_into(std::vector<double>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<int64_t>& numbers) const override;
+  virtual ExpType<void>
+  read_numbers_into(std::vector<uint64_t>& numbers) const override;
 
-  static JsonArray create(const simdjson::ondemand::array arr);
+  static JsonArray create(const Direct::SimdArray arr, Session* session);
 };
@@ -0,0 +1,181 @@
+#include "simd.hpp"
+
+#include "../internal.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SIMD_MMAP_FILES
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace simdjson;
+
+namespace {
+
+  using ParserPtr = std::unique_ptr<ondemand::parser>;
+
+  // parsers kept per thread, their buffers are reused by the next documents
+  constexpr std::size_t max_pooled_parsers = 4;
+  thread_local std::vector<ParserPtr> parser_pool;
+
+  ParserPtr lease_parser() {
+    if (parser_pool.empty()) {
+      return std::make_unique<ondemand::parser>();
+    }
+    auto parser = std::move(parser_pool.back());
+    parser_pool.pop_back();
+    return parser;
+  }
+
+  void release_parser(ParserPtr&& parser) {
+    if (parser && parser_pool.size() < max_pooled_parsers) {
+      parser_pool.push_back(std::move(parser));
+    }
+  }
+
+#ifdef SIMD_MMAP_FILES
+  using namespace JsonTypedefCodeGen;
+
+  UnexpJsonError file_error(const std::filesystem::path& path) {
+    const auto err = std::format("Can't map {}: {}", path.string(),
+                                 std::strerror(errno));
+    return make_json_error(JsonErrorTypes::InOut, err);
+  }
+
+  struct Mapping {
+    void* data = nullptr;
+    std::size_t size = 0, file_size = 0;
+  };
+
+  // reserves zeroed pages for the file plus the padding, then maps the file
+  // over the start of them. The end of the last file page is zero filled by
+  // the kernel, the following anonymous pages cover the rest of the padding
+  ExpType<Mapping> map_file(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return file_error(path);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      const auto err = file_error(path);
+      ::close(fd);
+      return err;
+    }
+
+    const std::size_t page = ::sysconf(_SC_PAGESIZE);
+    Mapping mapping;
+    mapping.file_size = static_cast<std::size_t>(st.st_size);
+    mapping.size =
+        (mapping.file_size + SIMDJSON_PADDING + page - 1) / page * page;
+
+    mapping.data = ::mmap(nullptr, mapping.size, PROT_READ,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping.data == MAP_FAILED) {
+      const auto err = file_error(path);
+      ::close(fd);
+      return err;
+    }
+
+    if (mapping.file_size != 0) {
+      const auto file_data =
+          ::mmap(mapping.data, mapping.file_size, PROT_READ,
+                 MAP_PRIVATE | MAP_FIXED, fd, 0);
+      if (file_data == MAP_FAILED) {
+        const auto err = file_error(path);
+        ::munmap(mapping.data, mapping.size);
+        ::close(fd);
+        return err;
+      }
+      // simdjson goes through the input front to back
+      ::madvise(mapping.data, mapping.file_size, MADV_SEQUENTIAL);
+    }
+
+    // the mapping keeps the file alive
+    ::close(fd);
+    return mapping;
+  }
+#endif
+
+} // namespace
+
+namespace JsonTypedefCodeGen::Reader {
+
+  DLL_PUBLIC SimdDocument::SimdDocument(const std::string_view json)
+      : SimdDocument(padded_string(json)) {}
+
+  DLL_PUBLIC SimdDocument::SimdDocument(const std::string& json)
+      : SimdDocument(padded_string(json)) {}
+
+  DLL_PUBLIC SimdDocument::SimdDocument(const char* json)
+      : SimdDocument(padded_string(std::string_view(json))) {}
+
+  DLL_PUBLIC SimdDocument::SimdDocument(padded_string&& json)
+      : m_parser(lease_parser()), m_json(std::move(json)) {
+    m_error = m_parser->iterate(m_json).get(m_document);
+  }
+
+  SimdDocument::SimdDocument(void* mapping, const std::size_t mapping_size,
+                             const padded_string_view json)
+      : m_parser(lease_parser()), m_mapping(mapping),
+        m_mapping_size(mapping_size) {
+    m_error = m_parser->iterate(json).get(m_document);
+  }
+
+  DLL_PUBLIC SimdDocument::~SimdDocument() {
+    // the document points inside the parser, release it first
+    m_document = ondemand::document();
+    release_parser(std::move(m_parser));
+#ifdef SIMD_MMAP_FILES
+    if (m_mapping != nullptr) {
+      ::munmap(m_mapping, m_mapping_size);
+    }
+#endif
+  }
+
+  DLL_PUBLIC ExpType<std::unique_ptr<SimdDocument>>
+  SimdDocument::from_file(const std::filesystem::path& path) {
+#ifdef SIMD_MMAP_FILES
+    return map_file(path).transform([](const Mapping& mapping) {
+      const padded_string_view json(static_cast<const char*>(mapping.data),
+                                    mapping.file_size, mapping.size);
+      // the constructor is private, no make_unique
+      return std::unique_ptr<SimdDocument>(
+          new SimdDocument(mapping.data, mapping.size, json));
+    });
+#else
+    padded_string json;
+    if (const auto err_type = padded_string::load(path.string()).get(json);
+        err_type != SUCCESS) {
+      return Direct::make_simdjson_error(err_type);
+    }
+    return std::make_unique<SimdDocument>(std::move(json));
+#endif
+  }
+
+  DLL_PUBLIC ExpType<JsonValue> SimdDocument::root(const bool count_items) {
+    if (m_error != SUCCESS) [[unlikely]] {
+      return Direct::make_simdjson_error(m_error);
+    }
+    // start over, the values read before are invalidated
+    m_document.rewind();
+    return simdjson_root_value(m_document.get_value(), m_session, count_items);
+  }
+
+  DLL_PUBLIC ExpType<Direct::SimdValue>
+  SimdDocument::direct_root(const bool count_items) {
+    if (m_error != SUCCESS) [[unlikely]] {
+      return Direct::make_simdjson_error(m_error);
+    }
+    m_document.rewind();
+    return Direct::simdjson_root_value(m_document.get_value(), count_items);
+  }
+
+} // namespace JsonTypedefCodeGen::Reader
@@ -3,54 +3,44 @@
 #include "value.hpp"
 
 ExpType<ObjectIteratorPair> SimdObjectIterator::get() const {
-  auto err_type = m_iter.error();
-  if (err_type == simdjson::SUCCESS) {
-    auto unsafe_val = m_iter.value_unsafe();
-    auto val = *unsafe_val;
-    err_type = val.error();
-    if (err_type == simdjson::SUCCESS) {
-      auto field = val.value_unsafe();
-      return ObjectIteratorPair{field.escaped_key(),
-                                SimdValue::create(field.value())};
-    }
-  }
-  return make_json_error(err_type);
+  return get_view().transform([](auto pair) {
+    return ObjectIteratorPair{std::string(pair.first), std::move(pair.second)};
+  });
 }
 
-void SimdObjectIterator::next() {
-  if (m_iter.error() == simdjson::SUCCESS) {
-    if (m_iter.value_unsafe() == m_end) {
-      // if it reached the end, invalidate it
-      m_iter = ObjIterResult(simdjson::OUT_OF_BOUNDS);
-    } else {
-      ++(m_iter.value_unsafe());
-    }
-  }
+ExpType<ObjectIteratorViewPair> SimdObjectIterator::get_view() const {
+  return (*m_iter).transform([this](const auto& pair) {
+    return ObjectIteratorViewPair{pair.first,
+                                  SimdValue::create(pair.second, m_session)};
+  });
 }
 
+void SimdObjectIterator::next() { ++m_iter; }
+
 bool SimdObjectIterator::done() const {
-  return m_iter.error() != simdjson::SUCCESS || m_iter.value_unsafe() == m_end;
+  return m_iter == std::default_sentinel_t{};
 }
 
-JsonObjectIterator SimdObjectIterator::create(ObjIterResult begin,
-                                              ObjIter end) {
+JsonObjectIterator
+SimdObjectIterator::create(const Direct::SimdObjectIterator iter,
+                           Session* session) {
   return create_json(
-      std::move(std::make_unique<SimdObjectIterator>(begin, end)));
+      Specialization::make_pimpl<SimdObjectIterator>(session, iter, session));
 }
 
 // -------------------------------------------
 JsonObjectIterator SimdObject::begin() const {
-  auto first = m_object.begin(), last = m_object.end();
-  ObjIter end; // default and invalid, never used if there's an error
-
-  if (const auto err_type = last.error(); err_type != simdjson::SUCCESS) {
-    first = ObjIterResult(err_type); // forward the error on the first iterator
-  } else {
-    end = last.value_unsafe();
-  }
-  return SimdObjectIterator::create(first, end);
+  return SimdObjectIterator::create(m_object.begin(), m_session);
 }
 
-JsonObject SimdObject::create(simdjson::ondemand::object obj) {
-  return create_json(std::move(std::make_unique<SimdObject>(obj)));
+std::size_t SimdObject::size_hint() const { return m_object.size_hint(); }
+
+ExpType<std::optional<std::string_view>>
+SimdObject::read_str_field(const std::string_view key) const {
+  return m_object.read_str_field(key);
+}
+
+JsonObject SimdObject::create(const Direct::SimdObject obj, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdObject>(session, obj, session));
 }
@@ -2,41 +2,45 @@
 
 #include "../spec_reader.hpp"
 
-#include "simdjson.h"
+#include "simd.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
-using ObjIter = simdjson::ondemand::object_iterator;
-using ObjIterResult = simdjson::simdjson_result<ObjIter>;
-
 class SimdObjectIterator final : public Specialization::ObjectIterator {
 private:
-  ObjIterResult m_iter;
-  ObjIter m_end;
+  Direct::SimdObjectIterator m_iter;
+  Session* m_session;
 
 public:
   SimdObjectIterator() = delete;
-  SimdObjectIterator(ObjIterResult begin, ObjIter end)
-      : m_iter(begin), m_end(end) {}
+  SimdObjectIterator(const Direct::SimdObjectIterator iter, Session* session)
+      : m_iter(iter), m_session(session) {}
 
   virtual ExpType<ObjectIteratorPair> get() const override;
+  virtual ExpType<ObjectIteratorViewPair> get_view() const override;
   virtual void next() override;
   virtual bool done() const override;
 
-  static JsonObjectIterator create(ObjIterResult begin, ObjIter end);
+  static JsonObjectIterator create(const Direct::SimdObjectIterator iter,
+                                   Session* session);
 };
 
 class SimdObject final : public Specialization::Object {
 private:
-  mutable simdjson::ondemand::object m_object;
+  Direct::SimdObject m_object;
+  Session* m_session;
 
 public:
   SimdObject() = delete;
-  SimdObject(simdjson::ondemand::object obj) : m_object(obj) {}
+  SimdObject(const Direct::SimdObject obj, Session* session)
+      : m_object(obj), m_session(session) {}
   ~SimdObject() {}
 
   virtual JsonObjectIterator begin() const override;
+  virtual std::size_t size_hint() const override;
+  virtual ExpType<std::optional<std::string_view>>
+  read_str_field(const std::string_view key) const override;
 
-  static JsonObject create(simdjson::ondemand::object obj);
+  static JsonObject create(const Direct::SimdObject obj, Session* session);
 };
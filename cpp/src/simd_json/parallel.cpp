@@ -0,0 +1,38 @@
+#include "simd.hpp"
+
+#include "../internal.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace JsonTypedefCodeGen::Reader::Direct {
+
+  DLL_PUBLIC void
+  parallel_chunks(const std::size_t count, const std::size_t threads,
+                  const std::function<bool(std::size_t, std::size_t)>& fn) {
+    std::atomic<std::size_t> next = 0;
+    std::atomic<bool> stop = false;
+
+    const auto work = [&](const std::size_t worker) {
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto chunk = next.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= count) {
+          break;
+        }
+        if (!fn(worker, chunk)) {
+          stop.store(true, std::memory_order_relaxed);
+        }
+      }
+    };
+
+    // the calling thread is the first worker
+    std::vector<std::jthread> workers;
+    workers.reserve(threads > 0 ? threads - 1 : 0);
+    for (std::size_t worker = 1; worker < threads; ++worker) {
+      workers.emplace_back(work, worker);
+    }
+    work(0);
+  }
+
+} // namespace JsonTypedefCodeGen::Reader::Direct
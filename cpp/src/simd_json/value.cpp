@@ -6,25 +6,6 @@
 
 using namespace simdjson::ondemand;
 
-static constexpr JsonTypes map_simd_types(const json_type type) {
-  switch (type) {
-  case json_type::array:
-    return JsonTypes::Array;
-  case json_type::boolean:
-    return JsonTypes::Bool;
-  case json_type::null:
-    return JsonTypes::Null;
-  case json_type::number:
-    return JsonTypes::Number;
-  case json_type::object:
-    return JsonTypes::Object;
-  case json_type::string:
-    return JsonTypes::String;
-  default:
-    return JsonTypes::Invalid;
-  }
-}
-
 static constexpr JsonErrorTypes
 map_err_type(const simdjson::error_code err_type) {
   switch (err_type) {
@@ -75,70 +56,43 @@ map_err_type(const simdjson::error_code err_type) {
 }
 
 // -------------------------------------------
-JsonTypes SimdValue::get_type() const { return map_simd_types(m_value.type()); }
-
-ExpType<bool> SimdValue::is_null() const {
-  auto tp = map_simd_data(m_value.type());
-  if (tp.has_value()) {
-    switch (tp.value()) {
-    case json_type::null:
-      return true;
-    default:
-      break;
-    };
-  }
-  return false;
-}
+JsonTypes SimdValue::get_type() const { return m_value.get_type(); }
 
-ExpType<bool> SimdValue::read_bool() const {
-  return map_simd_data(m_value.get_bool());
-}
+ExpType<bool> SimdValue::is_null() const { return m_value.is_null(); }
 
-ExpType<double> SimdValue::read_double() const {
-  return map_simd_data(m_value.get_double());
-}
+ExpType<bool> SimdValue::read_bool() const { return m_value.read_bool(); }
 
-ExpType<uint64_t> SimdValue::read_u64() const {
-  return map_simd_data(m_value.get_uint64());
-}
+ExpType<double> SimdValue::read_double() const { return m_value.read_double(); }
 
-ExpType<int64_t> SimdValue::read_i64() const {
-  return map_simd_data(m_value.get_int64());
-}
+ExpType<uint64_t> SimdValue::read_u64() const { return m_value.read_u64(); }
+
+ExpType<int64_t> SimdValue::read_i64() const { return m_value.read_i64(); }
 
-ExpType<std::string> SimdValue::read_str() const {
-  return map_simd_data(m_value.get_string())
-      .transform([](const std::string_view& sv) {
-        return std::string(sv);
-      });
+ExpType<std::string> SimdValue::read_str() const { return m_value.read_str(); }
+
+ExpType<std::string_view> SimdValue::read_str_view() const {
+  return m_value.read_str_view();
 }
 
 ExpType<JsonArray> SimdValue::read_array() const {
-  return map_simd_data(m_value.get_array()).transform(SimdArray::create);
+  return m_value.read_array().transform([this](const auto arr) {
+    return SimdArray::create(arr, m_session);
+  });
 }
 
 ExpType<JsonObject> SimdValue::read_object() const {
-  return map_simd_data(m_value.get_object()).transform(SimdObject::create);
+  return m_value.read_object().transform([this](const auto obj) {
+    return SimdObject::create(obj, m_session);
+  });
 }
 
 NumberType SimdValue::get_number_type() const {
-  if (m_value.type() == json_type::number) {
-    if (m_value.is_integer()) {
-      return m_value.is_negative() ? NumberType::I64 : NumberType::U64;
-    }
-    return NumberType::Double;
-  }
-  return NumberType::NaN;
+  return m_value.get_number_type();
 }
 
-JsonValue SimdValue::create(const simdjson::ondemand::value val) {
-  return create_json(std::move(std::make_unique<SimdValue>(val)));
-}
-
-// -------------------------------------------
-UnexpJsonError make_json_error(const simdjson::error_code err_type) {
-  return make_json_error(map_err_type(err_type),
-                         std::string(simdjson::error_message(err_type)));
+JsonValue SimdValue::create(const Direct::SimdValue val, Session* session) {
+  return create_json(
+      Specialization::make_pimpl<SimdValue>(session, val, session));
 }
 
 // -------------------------------------------
@@ -148,12 +102,27 @@ namespace JsonTypedefCodeGen::Reader {
   using namespace simdjson;
 
   DLL_PUBLIC ExpType<JsonValue>
-  simdjson_root_value(const simdjson::simdjson_result<ondemand::value> root) {
-    if (const auto err_code = root.error(); err_code == simdjson::SUCCESS) {
-      return SimdValue::create(root.value_unsafe());
-    } else {
-      return ::make_json_error(err_code);
-    }
+  simdjson_root_value(const simdjson::simdjson_result<ondemand::value> root,
+                      const bool count_items) {
+    return Direct::simdjson_root_value(root, count_items)
+        .transform([](const auto val) {
+          return SimdValue::create(val, nullptr);
+        });
+  }
+
+  DLL_PUBLIC ExpType<JsonValue>
+  simdjson_root_value(const simdjson::simdjson_result<ondemand::value> root,
+                      Session& session, const bool count_items) {
+    return Direct::simdjson_root_value(root, count_items)
+        .transform([&session](auto val) {
+          return SimdValue::create(val, &session);
+        });
+  }
+
+  DLL_PUBLIC UnexpJsonError
+  Direct::make_simdjson_error(const simdjson::error_code err_type) {
+    return make_json_error(map_err_type(err_type),
+                           std::string(simdjson::error_message(err_type)));
   }
 
 } // namespace JsonTypedefCodeGen::Reader
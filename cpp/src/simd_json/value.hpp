@@ -2,18 +2,21 @@
 
 #include "../spec_reader.hpp"
 
-#include "simdjson.h"
+#include "simd.hpp"
 
 using namespace JsonTypedefCodeGen;
 using namespace JsonTypedefCodeGen::Reader;
 
+// type erased wrapper around the compile-time reader "Direct::SimdValue"
 class SimdValue final : public Specialization::Value {
 private:
-  mutable simdjson::ondemand::value m_value;
+  Direct::SimdValue m_value;
+  Session* m_session;
 
 public:
   SimdValue() = delete;
-  SimdValue(const simdjson::ondemand::value val) : m_value(val) {}
+  SimdValue(const Direct::SimdValue val, Session* session)
+      : m_value(val), m_session(session) {}
   ~SimdValue() {}
 
   virtual JsonTypes get_type() const override;
@@ -24,22 +27,11 @@ public:
   virtual ExpType<uint64_t> read_u64() const override;
   virtual ExpType<int64_t> read_i64() const override;
   virtual ExpType<std::string> read_str() const override;
+  virtual ExpType<std::string_view> read_str_view() const override;
   virtual ExpType<JsonArray> read_array() const override;
   virtual ExpType<JsonObject> read_object() const override;
 
   virtual NumberType get_number_type() const override;
 
-  static JsonValue create(const simdjson::ondemand::value val);
+  static JsonValue create(const Direct::SimdValue val, Session* session);
 };
-
-// -------------------------------------------
-UnexpJsonError make_json_error(const simdjson::error_code err_type);
-
-template <typename Type>
-ExpType<Type> map_simd_data(simdjson::simdjson_result<Type> data) {
-  const auto err_type = data.error();
-  [[likely]] if (err_type == simdjson::SUCCESS) {
-    return ExpType<Type>(data.value());
-  }
-  return make_json_error(err_type);
-}
@@ -2,9 +2,28 @@
 
 #include "json_reader.hpp"
 
+#include <new>
+#include <utility>
+
 // internal specialization for each library
 namespace JsonTypedefCodeGen::Reader::Specialization {
 
+  // allocate a pimpl object from the session pool, or the heap without one
+  template <typename T, typename... Args>
+  std::unique_ptr<T, PimplDeleter> make_pimpl(Session* session,
+                                              Args&&... args) {
+    if (session == nullptr) {
+      return std::unique_ptr<T, PimplDeleter>(
+          new T(std::forward<Args>(args)...));
+    }
+
+    auto* resource = session->resource();
+    void* mem = resource->allocate(sizeof(T), alignof(T));
+    return std::unique_ptr<T, PimplDeleter>(
+        new (mem) T(std::forward<Args>(args)...),
+        PimplDeleter{resource, sizeof(T), alignof(T)});
+  }
+
   class ArrayIterator : public BaseArrayIterator {
   public:
     virtual ~ArrayIterator();
@@ -19,6 +38,7 @@ namespace JsonTypedefCodeGen::Reader::Specialization {
     virtual ~ObjectIterator();
 
     virtual ExpType<ObjectIteratorPair> get() const = 0;
+    virtual ExpType<ObjectIteratorViewPair> get_view() const = 0;
     virtual void next() = 0;
     virtual bool done() const = 0;
   };
@@ -28,6 +48,17 @@ namespace JsonTypedefCodeGen::Reader::Specialization {
     virtual ~Array();
 
     virtual JsonArrayIterator begin() const = 0;
+
+    // number of items when known without walking the array, 0 otherwise
+    virtual std::size_t size_hint() const;
+
+    // read item by item by default, the libraries override them with a loop
+    // not creating a JsonValue per item
+    virtual ExpType<void> read_numbers_into(std::vector<double>& numbers) const;
+    virtual ExpType<void>
+    read_numbers_into(std::vector<int64_t>& numbers) const;
+    virtual ExpType<void>
+    read_numbers_into(std::vector<uint64_t>& numbers) const;
   };
 
   class Object : public BaseObject {
@@ -35,6 +66,12 @@ namespace JsonTypedefCodeGen::Reader::Specialization {
     virtual ~Object();
 
     virtual JsonObjectIterator begin() const = 0;
+
+    // number of fields when known without walking the object, 0 otherwise
+    virtual std::size_t size_hint() const;
+
+    virtual ExpType<std::optional<std::string_view>>
+    read_str_field(const std::string_view key) const = 0;
   };
 
   class Value : public BaseValue {
@@ -49,6 +86,7 @@ namespace JsonTypedefCodeGen::Reader::Specialization {
     virtual ExpType<uint64_t> read_u64() const = 0;
     virtual ExpType<int64_t> read_i64() const = 0;
     virtual ExpType<std::string> read_str() const = 0;
+    virtual ExpType<std::string_view> read_str_view() const = 0;
     virtual ExpType<JsonArray> read_array() const = 0;
     virtual ExpType<JsonObject> read_object() const = 0;
 
@@ -15,6 +15,8 @@ namespace JsonTypedefCodeGen::Writer::Specialization {
 
     virtual ExpType<void> write_null() = 0;
     virtual ExpType<void> write_bool(const bool b) = 0;
+    // by default the shortest text of the float is written as a double
+    virtual ExpType<void> write_float(const float f);
     virtual ExpType<void> write_double(const double d) = 0;
     virtual ExpType<void> write_i64(const int64_t i) = 0;
     virtual ExpType<void> write_u64(const uint64_t u) = 0;
@@ -22,6 +24,8 @@ namespace JsonTypedefCodeGen::Writer::Specialization {
 
     virtual ExpType<void> start_object() = 0;
     virtual ExpType<void> write_key(const std::string_view key) = 0;
+    // by default only the key is used
+    virtual ExpType<void> write_key_token(const KeyToken& key);
     virtual ExpType<void> end_object() = 0;
 
     virtual ExpType<void> start_array() = 0;
@@ -1,10 +1,23 @@
 #include "serializer.hpp"
 
+#include "../../include/direct_writer.hpp"
 #include "../../include/stream_serializer.hpp"
 #include "../internal.hpp"
+#include "../json_escape.hpp"
 
-#include <format>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <memory>
+#include <ostream>
+#include <utility>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
 
 using namespace std::string_view_literals;
 using namespace JsonTypedefCodeGen::Writer::Specialization;
@@ -20,6 +33,9 @@ ExpType<void> InternalStreamSerializer::write_null() {
 ExpType<void> InternalStreamSerializer::write_bool(const bool b) {
   return m_str_ser->write_bool(b);
 }
+ExpType<void> InternalStreamSerializer::write_float(const float f) {
+  return m_str_ser->write_float(f);
+}
 ExpType<void> InternalStreamSerializer::write_double(const double d) {
   return m_str_ser->write_double(d);
 }
@@ -39,6 +55,9 @@ ExpType<void> InternalStreamSerializer::start_object() {
 ExpType<void> InternalStreamSerializer::write_key(const std::string_view key) {
   return m_str_ser->write_key(key);
 }
+ExpType<void> InternalStreamSerializer::write_key_token(const KeyToken& key) {
+  return m_str_ser->write_key_token(key);
+}
 ExpType<void> InternalStreamSerializer::end_object() {
   return m_str_ser->end_object();
 }
@@ -58,36 +77,172 @@ Serializer InternalStreamSerializer::create(StreamSerializer& str_ser) {
 // -------------------------------------------
 namespace JsonTypedefCodeGen::Writer {
 
-  StreamSerializer::StreamSerializer(const StreamSerializerCreateInfo& info)
-      : m_os(info.output_stream),               //
-        m_pretty(info.pretty),                  //
-        m_close_root_item(info.open_root_item), //
-        m_indent(info.depth),                   //
-        m_indent_str(info.indent) {
+  namespace {
+
+    // large enough for to_chars' shortest double and any 64 bits integer
+    constexpr std::size_t max_number_size = 32;
+    constexpr std::size_t min_buffer_size = 256;
+    // the fixed notation writes every digit before the point, up to 309
+    constexpr int max_float_precision = 20;
+    constexpr std::size_t max_fixed_size = 1 + 309 + 1 + max_float_precision;
+
+    UnexpJsonError sink_failed_error() {
+      return make_json_error(JsonErrorTypes::InOut,
+                             "the output failed, the JSON is incomplete"sv);
+    }
+
+    StreamSink make_ostream_sink(std::ostream* os) {
+      return [os](const std::string_view text) -> ExpType<void> {
+        os->write(text.data(), std::streamsize(text.size()));
+        if (!os->good()) [[unlikely]] {
+          return make_json_error(JsonErrorTypes::InOut,
+                                 "cannot write to the output stream"sv);
+        }
+        return ExpType<void>();
+      };
+    }
+
+    StreamSink make_fd_sink(const int fd) {
+      return [fd](std::string_view text) -> ExpType<void> {
+        while (!text.empty()) {
+#if defined(_WIN32)
+          const auto count = ::_write(fd, text.data(), unsigned(text.size()));
+#else
+          const auto count = ::write(fd, text.data(), text.size());
+          if (count < 0 && errno == EINTR) {
+            continue;
+          }
+#endif
+          if (count <= 0) [[unlikely]] {
+            return make_json_error(JsonErrorTypes::InOut,
+                                   "cannot write to the file descriptor"sv);
+          }
+          text.remove_prefix(std::size_t(count));
+        }
+        return ExpType<void>();
+      };
+    }
+
+  } // namespace
+
+  StreamSerializer::StreamSerializer(const StreamSerializerCreateInfo& info,
+                                     StreamSink&& sink)
+      : m_sink(std::move(sink)),
+        m_buffer(std::make_unique_for_overwrite<char[]>(info.buffer_size)),
+        m_capacity(info.buffer_size),             //
+        m_float_format(info.float_format),        //
+        m_float_precision(info.float_precision),  //
+        m_indent(info.depth),                     //
+        m_indent_str(info.indent),                //
+        m_pretty(info.pretty),                    //
+        m_close_root_item(info.open_root_item) {
     m_status.emplace(Status{.is_array = info.start_as_array,
                             .is_first_item = true,
                             .last_item_is_a_key = false});
     if (info.open_root_item) {
-      (*m_os) << (info.start_as_array ? "["sv : "{"sv);
+      // the buffer is empty, it can't fail
+      (void)write_raw(info.start_as_array ? "["sv : "{"sv);
+    }
+  }
+
+  DLL_PUBLIC StreamSerializer::~StreamSerializer() {
+    // a moved-from serializer has no buffer
+    if (m_buffer) {
+      (void)flush();
+    }
+  }
+
+  DLL_PUBLIC ExpType<void> StreamSerializer::flush() {
+    if (m_sink_failed) [[unlikely]] {
+      return sink_failed_error();
+    }
+    if (m_used == 0) {
+      return ExpType<void>();
+    }
+    const auto used = std::exchange(m_used, 0);
+    return write_sink(std::string_view(m_buffer.get(), used));
+  }
+
+  // the sink may have written part of the text, it's not sent again
+  ExpType<void> StreamSerializer::write_sink(const std::string_view text) {
+    auto exp = m_sink(text);
+    if (!exp.has_value()) [[unlikely]] {
+      m_sink_failed = true;
+    }
+    return exp;
+  }
+
+  ExpType<void> StreamSerializer::write_raw(const std::string_view text) {
+    if (text.size() > m_capacity - m_used) [[unlikely]] {
+      if (auto exp = flush(); !exp.has_value()) {
+        return exp;
+      }
+      // too large to be buffered
+      if (text.size() > m_capacity) {
+        return write_sink(text);
+      }
+    }
+    std::memcpy(m_buffer.get() + m_used, text.data(), text.size());
+    m_used += text.size();
+    return ExpType<void>();
+  }
+
+  // the clean runs between the characters to escape are copied as they are
+  ExpType<void> StreamSerializer::write_escaped(const std::string_view text) {
+    return write_json_escaped(text, [this](const std::string_view part) {
+      return write_raw(part);
+    });
+  }
+
+  template <typename NumT>
+  ExpType<void> StreamSerializer::write_number(const NumT num) {
+    if (max_number_size > m_capacity - m_used) [[unlikely]] {
+      if (auto exp = flush(); !exp.has_value()) {
+        return exp;
+      }
+    }
+    auto* first = m_buffer.get() + m_used;
+    const auto [last, ec] = std::to_chars(first, first + max_number_size, num);
+    m_used += std::size_t(last - first);
+    return ExpType<void>();
+  }
+
+  template <typename FloatT>
+  ExpType<void> StreamSerializer::write_floating(const FloatT num) {
+    if (m_float_format == FloatFormat::Shortest) {
+      // to_chars picks the shortest text for the width of FloatT
+      return write_number(num);
     }
+    char text[max_fixed_size];
+    const auto [last, ec] =
+        std::to_chars(text, text + max_fixed_size, num,
+                      std::chars_format::fixed, m_float_precision);
+    return write_raw(std::string_view(text, last));
   }
 
-  void StreamSerializer::write_indent() {
+  ExpType<void> StreamSerializer::write_indent() {
     if (m_pretty) {
-      (*m_os) << "\n"sv;
+      if (auto exp = write_raw("\n"sv); !exp.has_value()) {
+        return exp;
+      }
       for (int i = 0; i < m_indent; ++i) {
-        (*m_os) << m_indent_str;
+        if (auto exp = write_raw(m_indent_str); !exp.has_value()) {
+          return exp;
+        }
       }
     }
+    return ExpType<void>();
   }
 
-  void StreamSerializer::end_item() {
+  ExpType<void> StreamSerializer::end_item() {
     if (top().is_first_item) {
       top().is_first_item = false;
-    } else {
-      (*m_os) << ","sv;
-      write_indent();
+      return ExpType<void>();
+    }
+    if (auto exp = write_raw(","sv); !exp.has_value()) {
+      return exp;
     }
+    return write_indent();
   }
 
   DLL_PUBLIC ExpType<void> StreamSerializer::close() {
@@ -98,16 +253,28 @@ namespace JsonTypedefCodeGen::Writer {
     m_closed = true;
     --m_indent;
     if (m_close_root_item) {
-      write_indent();
-      (*m_os) << (top().is_array ? "]"sv : "}"sv);
+      if (auto exp = write_indent(); !exp.has_value()) {
+        return exp;
+      }
+      if (auto exp = write_raw(top().is_array ? "]"sv : "}"sv);
+          !exp.has_value()) {
+        return exp;
+      }
     }
-    return ExpType<void>();
+    return flush();
   }
 
+#define SHORT_EXP(expr)                                                        \
+  if (auto exp = (expr); !exp.has_value()) {                                   \
+    return exp;                                                                \
+  }
 #define CHECK_CLOSED                                                           \
   if (m_closed) {                                                              \
     return make_json_error(JsonErrorTypes::Invalid,                            \
                            "string serializer already closed"sv);              \
+  }                                                                            \
+  if (m_sink_failed) [[unlikely]] {                                            \
+    return sink_failed_error();                                                \
   }
 #define CHECK_KEY                                                              \
   if (!top().is_array) {                                                       \
@@ -119,67 +286,68 @@ namespace JsonTypedefCodeGen::Writer {
       top().last_item_is_a_key = false;                                        \
     }                                                                          \
   } else {                                                                     \
-    end_item();                                                                \
+    SHORT_EXP(end_item());                                                     \
   }
 
   DLL_PUBLIC ExpType<void> StreamSerializer::write_null() {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << "null"sv;
-    return ExpType<void>();
+    return write_raw("null"sv);
   }
   DLL_PUBLIC ExpType<void> StreamSerializer::write_bool(const bool b) {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << (b ? "true"sv : "false"sv);
-    return ExpType<void>();
+    return write_raw(b ? "true"sv : "false"sv);
+  }
+  DLL_PUBLIC ExpType<void> StreamSerializer::write_float(const float f) {
+    CHECK_CLOSED;
+    CHECK_KEY;
+
+    return write_floating(f);
   }
   DLL_PUBLIC ExpType<void> StreamSerializer::write_double(const double d) {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << std::format("{}"sv, d);
-    return ExpType<void>();
+    return write_floating(d);
   }
   DLL_PUBLIC ExpType<void> StreamSerializer::write_i64(const int64_t i) {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << std::format("{}"sv, i);
-    return ExpType<void>();
+    return write_number(i);
   }
   DLL_PUBLIC ExpType<void> StreamSerializer::write_u64(const uint64_t u) {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << std::format("{}"sv, u);
-    return ExpType<void>();
+    return write_number(u);
   }
   DLL_PUBLIC ExpType<void>
   StreamSerializer::write_str(const std::string_view str) {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << std::format("\"{}\""sv, str);
-    return ExpType<void>();
+    SHORT_EXP(write_raw("\""sv));
+    SHORT_EXP(write_escaped(str));
+    return write_raw("\""sv);
   }
 
   DLL_PUBLIC ExpType<void> StreamSerializer::start_object() {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << "{"sv;
+    SHORT_EXP(write_raw("{"sv));
     ++m_indent;
-    write_indent();
+    SHORT_EXP(write_indent());
     m_status.emplace(Status{
         .is_array = false, .is_first_item = true, .last_item_is_a_key = false});
 
     return ExpType<void>();
   }
-  DLL_PUBLIC ExpType<void>
-  StreamSerializer::write_key(const std::string_view key) {
+  ExpType<void> StreamSerializer::start_key() {
     CHECK_CLOSED;
 
     if (top().is_array) {
@@ -191,12 +359,24 @@ namespace JsonTypedefCodeGen::Writer {
                              "cannot write two keys in a row"sv);
     }
 
-    end_item();
+    SHORT_EXP(end_item());
     top().last_item_is_a_key = true;
-
-    (*m_os) << std::format("\"{}\":"sv, key);
     return ExpType<void>();
   }
+  DLL_PUBLIC ExpType<void>
+  StreamSerializer::write_key(const std::string_view key) {
+    SHORT_EXP(start_key());
+
+    SHORT_EXP(write_raw("\""sv));
+    SHORT_EXP(write_escaped(key));
+    return write_raw("\":"sv);
+  }
+  DLL_PUBLIC ExpType<void>
+  StreamSerializer::write_key_token(const KeyToken& key) {
+    SHORT_EXP(start_key());
+
+    return write_raw(key.token);
+  }
   DLL_PUBLIC ExpType<void> StreamSerializer::end_object() {
     CHECK_CLOSED;
     if (top().is_array) {
@@ -207,8 +387,8 @@ namespace JsonTypedefCodeGen::Writer {
                              "cannot end an object with an empty key"sv);
     }
     --m_indent;
-    write_indent();
-    (*m_os) << "}"sv;
+    SHORT_EXP(write_indent());
+    SHORT_EXP(write_raw("}"sv));
     m_status.pop();
     if (m_status.empty()) {
       return make_json_error(JsonErrorTypes::Invalid, "empty root item"sv);
@@ -220,9 +400,9 @@ namespace JsonTypedefCodeGen::Writer {
     CHECK_CLOSED;
     CHECK_KEY;
 
-    (*m_os) << "["sv;
+    SHORT_EXP(write_raw("["sv));
     ++m_indent;
-    write_indent();
+    SHORT_EXP(write_indent());
     m_status.emplace(Status{
         .is_array = true, .is_first_item = true, .last_item_is_a_key = false});
 
@@ -235,8 +415,8 @@ namespace JsonTypedefCodeGen::Writer {
                              "cannot end an object as an array"sv);
     }
     --m_indent;
-    write_indent();
-    (*m_os) << "]"sv;
+    SHORT_EXP(write_indent());
+    SHORT_EXP(write_raw("]"sv));
     m_status.pop();
     if (m_status.empty()) {
       return make_json_error(JsonErrorTypes::Invalid, "empty root item"sv);
@@ -246,13 +426,38 @@ namespace JsonTypedefCodeGen::Writer {
 
 #undef CHECK_KEY
 #undef CHECK_CLOSED
+#undef SHORT_EXP
+
+  DLL_PUBLIC ExpType<void> StreamSerializer::write(const Data::JsonArray& arr) {
+    InternalStreamSerializer internal(*this);
+    return internal.write(arr);
+  }
+  DLL_PUBLIC ExpType<void>
+  StreamSerializer::write(const Data::JsonObject& obj) {
+    InternalStreamSerializer internal(*this);
+    return internal.write(obj);
+  }
+  DLL_PUBLIC ExpType<void> StreamSerializer::write(const Data::JsonValue& val) {
+    InternalStreamSerializer internal(*this);
+    return internal.write(val);
+  }
+
+  static_assert(Direct::Serializer<StreamSerializer>);
+  static_assert(Direct::Serializer<Serializer>);
 
   DLL_PUBLIC ExpType<StreamSerializer>
   StreamSerializer::create(const StreamSerializerCreateInfo& info) {
-    if (info.output_stream == nullptr) {
+    StreamSink sink;
+    if (info.output_stream != nullptr) {
+      sink = make_ostream_sink(info.output_stream);
+    } else if (info.output_fd >= 0) {
+      sink = make_fd_sink(info.output_fd);
+    } else if (info.output_sink) {
+      sink = info.output_sink;
+    } else {
       return make_json_error(
           JsonErrorTypes::InOut,
-          "missing output stream in StreamSerializerCreateInfo"sv);
+          "missing output in StreamSerializerCreateInfo"sv);
     }
 
     StreamSerializerCreateInfo copy = info;
@@ -262,7 +467,10 @@ namespace JsonTypedefCodeGen::Writer {
     if (copy.depth < 1) {
       copy.depth = 1;
     }
-    return StreamSerializer(copy);
+    copy.buffer_size = std::max(copy.buffer_size, min_buffer_size);
+    copy.float_precision =
+        std::clamp(copy.float_precision, 0, max_float_precision);
+    return StreamSerializer(copy, std::move(sink));
   }
 
   DLL_PUBLIC ExpType<Serializer>
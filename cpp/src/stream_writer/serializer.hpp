@@ -21,6 +21,7 @@ public:
 
   virtual ExpType<void> write_null() override;
   virtual ExpType<void> write_bool(const bool b) override;
+  virtual ExpType<void> write_float(const float f) override;
   virtual ExpType<void> write_double(const double d) override;
   virtual ExpType<void> write_i64(const int64_t i) override;
   virtual ExpType<void> write_u64(const uint64_t u) override;
@@ -28,6 +29,7 @@ public:
 
   virtual ExpType<void> start_object() override;
   virtual ExpType<void> write_key(const std::string_view key) override;
+  virtual ExpType<void> write_key_token(const KeyToken& key) override;
   virtual ExpType<void> end_object() override;
 
   virtual ExpType<void> start_array() override;
@@ -45,7 +45,10 @@ namespace {
           return make_json_error(JsonErrorTypes::Invalid);
         }));
 
-    return flatten_expected(exp_enum.transform(test::deserialize_BasicEnum));
+    return flatten_expected(
+        exp_enum.transform([](const Reader::JsonValue& val) {
+          return test::deserialize_BasicEnum(val);
+        }));
   }
 
   ExpBasicStruct get_exp_basic_struct(const padded_str& json_str) {
@@ -247,6 +250,24 @@ TEST(BASIC_DES, discriminator_ok) {
 
 TEST(BASIC_DES, discriminator_err) {
   using Types = test::BasicDisc::Types;
+  // missing "Type"
+  {
+    auto exp_bd = get_exp_basic_disc(R"( { "baz": "Baz" } )"_padded);
+
+    EXPECT_FALSE(exp_bd.has_value());
+    exp_error(exp_bd.error(),
+              JsonError(JsonErrorTypes::String,
+                        "Missing key \"Type\" for BasicDisc"sv));
+  }
+  // "Type" isn't a string
+  {
+    auto exp_bd = get_exp_basic_disc(R"( { "Type": 3 } )"_padded);
+
+    EXPECT_FALSE(exp_bd.has_value());
+    exp_error(exp_bd.error(),
+              JsonError(JsonErrorTypes::Invalid,
+                        "Expected string value for Type"sv));
+  }
   // invalid "Type"
   {
     auto exp_bd = get_exp_basic_disc(R"( { "Type": "Bob" } )"_padded);
@@ -5,10 +5,13 @@
 #include "generated/primitives.hpp"
 
 #include "common_serialization.hpp"
+#include "direct_writer.hpp"
 #include "stream_serializer.hpp"
 
 #include <gtest/gtest.h>
 #include <sstream>
+#include <string>
+#include <utility>
 
 using namespace JsonTypedefCodeGen;
 using namespace std::string_view_literals;
@@ -94,6 +97,177 @@ TEST(BASIC_SER, invalid_stream_serializer) {
   EXPECT_FALSE(exp_err.has_value());
 }
 
+TEST(BASIC_SER, buffered_sink) {
+  std::string output;
+  int flushes = 0;
+
+  JW::StreamSerializerCreateInfo info;
+  info.start_as_array = true;
+  info.open_root_item = true;
+  info.buffer_size = 256;
+  info.output_sink = [&](const std::string_view text) -> ExpType<void> {
+    output.append(text);
+    ++flushes;
+    return ExpType<void>();
+  };
+  auto exp_str_ser = JW::StreamSerializer::create(info);
+  EXPECT_TRUE(exp_str_ser.has_value());
+
+  auto& str_ser = exp_str_ser.value();
+  for (int i = 0; i < 30; ++i) {
+    EXPECT_TRUE(str_ser.write_i64(-1000 - i).has_value());
+  }
+  // nothing is written until the buffer is full
+  EXPECT_EQ(flushes, 0);
+
+  // the buffer is flushed, then the string too large for it written as is
+  const std::string large(300, 'x');
+  EXPECT_TRUE(str_ser.write_str(large).has_value());
+  EXPECT_EQ(flushes, 2);
+  EXPECT_EQ(output.size(), 182 + 300);
+
+  EXPECT_TRUE(str_ser.write_double(0.5).has_value());
+  EXPECT_TRUE(str_ser.close().has_value());
+  EXPECT_EQ(flushes, 3);
+  EXPECT_TRUE(output.starts_with("[-1000,-1001,"sv));
+  EXPECT_TRUE(output.ends_with("-1029,\"" + large + "\",0.5]"));
+}
+
+TEST(BASIC_SER, failing_sink) {
+  JW::StreamSerializerCreateInfo info;
+  info.start_as_array = true;
+  info.output_sink = [](const std::string_view) -> ExpType<void> {
+    return make_json_error(JsonErrorTypes::InOut, "full"sv);
+  };
+  auto exp_str_ser = JW::StreamSerializer::create(info);
+  EXPECT_TRUE(exp_str_ser.has_value());
+
+  // the error comes when flushing
+  EXPECT_TRUE(exp_str_ser.value().write_bool(true).has_value());
+  const auto exp_err = exp_str_ser.value().close();
+  EXPECT_FALSE(exp_err.has_value());
+  EXPECT_EQ(exp_err.error().type, JsonErrorTypes::InOut);
+
+  // once the output failed, the text is incomplete even if it recovers
+  std::string output;
+  bool failed_once = false;
+  info.output_sink = [&](const std::string_view text) -> ExpType<void> {
+    if (!std::exchange(failed_once, true)) {
+      return make_json_error(JsonErrorTypes::InOut, "busy"sv);
+    }
+    output.append(text);
+    return ExpType<void>();
+  };
+  auto exp_recover = JW::StreamSerializer::create(info);
+  EXPECT_TRUE(exp_recover.has_value());
+  auto& recover = exp_recover.value();
+
+  EXPECT_TRUE(recover.write_bool(true).has_value());
+  const auto exp_flush = recover.flush();
+  EXPECT_FALSE(exp_flush.has_value());
+  EXPECT_EQ(exp_flush.error().type, JsonErrorTypes::InOut);
+
+  const auto exp_write = recover.write_bool(false);
+  EXPECT_FALSE(exp_write.has_value());
+  EXPECT_EQ(exp_write.error().type, JsonErrorTypes::InOut);
+  const auto exp_close = recover.close();
+  EXPECT_FALSE(exp_close.has_value());
+  EXPECT_EQ(exp_close.error().type, JsonErrorTypes::InOut);
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(BASIC_SER, escaped_strings) {
+  const auto serialize_str = [](const std::string_view str) {
+    return execute_as_array([str](auto& serializer) {
+      return serializer.write_str(str);
+    });
+  };
+  const auto expect_str = [&](const std::string_view str,
+                              const std::string_view expected_json) {
+    const auto exp_str = serialize_str(str);
+    EXPECT_TRUE(exp_str.has_value());
+    EXPECT_EQ(exp_str.value(), expected_json);
+  };
+
+  expect_str("say \"hi\"\\ \t\n\r\b\f"sv,
+             R"("say \"hi\"\\ \t\n\r\b\f")"sv);
+  expect_str(std::string_view("a\0b\x1f", 4), R"("a\u0000b\u001f")"sv);
+  // UTF-8 is written as it is
+  expect_str("caf\xc3\xa9"sv, "\"caf\xc3\xa9\""sv);
+
+  // characters to escape in the blocks scanned at once, and in the tail
+  for (const std::size_t pos : {0, 15, 16, 31, 32, 47, 63, 70}) {
+    std::string str(71, 'x');
+    str[pos] = '"';
+    const auto exp_str = serialize_str(str);
+    EXPECT_TRUE(exp_str.has_value());
+    EXPECT_EQ(exp_str.value(), "\"" + str.substr(0, pos) + "\\\"" +
+                                   str.substr(pos + 1) + "\"");
+  }
+}
+
+TEST(BASIC_SER, escaped_key) {
+  serialize_and_expected_json(
+      [](auto& serializer) {
+        return chain_void_expected({serializer.start_object(),
+                                    serializer.write_key("a\"b"sv),
+                                    serializer.write_null(),
+                                    serializer.end_object()});
+      },
+      R"({"a\"b":null})"sv);
+}
+
+TEST(BASIC_SER, float_shortest) {
+  serialize_and_expected_json(
+      [](auto& serializer) {
+        return chain_void_expected(
+            {serializer.start_array(),
+             Serialize::Serialize<float>::serialize(serializer, 0.1f),
+             serializer.write_double(0.1), serializer.write_float(1e-7f),
+             serializer.write_double(1e300), serializer.end_array()});
+      },
+      "[0.1,0.1,1e-07,1e+300]"sv);
+}
+
+TEST(BASIC_SER, float_fixed) {
+  std::stringstream ss;
+  JW::StreamSerializerCreateInfo info;
+  info.start_as_array = true;
+  info.open_root_item = true;
+  info.output_stream = &ss;
+  info.float_format = JW::FloatFormat::Fixed;
+  info.float_precision = 2;
+  auto exp_str_ser = JW::StreamSerializer::create(info);
+  EXPECT_TRUE(exp_str_ser.has_value());
+
+  auto& str_ser = exp_str_ser.value();
+  EXPECT_TRUE(str_ser.write_double(3.14159).has_value());
+  EXPECT_TRUE(str_ser.write_float(2.5f).has_value());
+  EXPECT_TRUE(str_ser.write_double(-1e20).has_value());
+  EXPECT_TRUE(str_ser.write_i64(7).has_value());
+  EXPECT_TRUE(str_ser.close().has_value());
+  EXPECT_EQ(ss.str(), "[3.14,2.50,-100000000000000000000.00,7]");
+}
+
+TEST(BASIC_SER, key_tokens) {
+  // the token is written as it is, the key isn't used
+  serialize_and_expected_json(
+      [](auto& serializer) {
+        return chain_void_expected(
+            {serializer.start_object(),
+             serializer.write_key_token({"a\"b"sv, R"("a\"b":)"sv}),
+             serializer.write_null(),
+             serializer.write_key_token({"c"sv, R"("c":)"sv}),
+             serializer.write_bool(true), serializer.end_object()});
+      },
+      R"({"a\"b":null,"c":true})"sv);
+
+  const auto exp_err = execute_as_array([](auto& serializer) {
+    return serializer.write_key_token({"c"sv, R"("c":)"sv});
+  });
+  EXPECT_FALSE(exp_err.has_value());
+}
+
 TEST(BASIC_SER, cannot_write_key_in_array) {
   auto exp_err = execute_as_array([](auto& serializer) {
     return serializer.write_key("Bob"sv);
@@ -136,3 +310,25 @@ TEST(BASIC_SER, disc_ok) {
       },
       "{\"Type\":\"String\",\"baz\":\"Bob\"}"sv);
 }
+
+TEST(BASIC_SER, direct_stream_serializer) {
+  static_assert(JW::Direct::Serializer<JW::StreamSerializer> &&
+                JW::Direct::Serializer<JW::Serializer>);
+
+  std::stringstream ss;
+  auto exp_str_ser = create_array_string_ser(&ss);
+  EXPECT_TRUE(exp_str_ser.has_value());
+
+  // the overload taking the StreamSerializer calls it without a Serializer
+  auto& str_ser = exp_str_ser.value();
+  test::BasicStruct basic{.bar = "Bob", .baz = {true, false}, .foo = true};
+  EXPECT_TRUE(test::serialize_BasicStruct(str_ser, basic).has_value());
+
+  Data::JsonArray array;
+  array.internal() = {Data::JsonValue(1.5), Data::JsonValue("a"sv)};
+  EXPECT_TRUE(str_ser.write(array).has_value());
+  EXPECT_TRUE(str_ser.close().has_value());
+
+  EXPECT_EQ(ss.str(),
+            "{\"bar\":\"Bob\",\"baz\":[true,false],\"foo\":true},[1.5,\"a\"]");
+}
@@ -0,0 +1,360 @@
+#if defined(USE_SIMD) && defined(USE_IN_NLOH)
+
+#include "generated/basic_disc.hpp"
+#include "generated/basic_enum.hpp"
+#include "generated/basic_struct.hpp"
+#include "generated/dictionary.hpp"
+#include "generated/number_arrays.hpp"
+#include "generated/primitives.hpp"
+#include "nlohmann.hpp"
+#include "simd.hpp"
+
+#include <array>
+#include <format>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace JsonTypedefCodeGen;
+using namespace simdjson;
+using namespace std::string_view_literals;
+using namespace nlohmann::json_literals;
+
+namespace {
+
+  // the parser must outlive the values read from it
+  template <typename Fn>
+  auto simd_direct(const padded_string& json_str, Fn deserialize) {
+    ondemand::parser parser;
+    auto doc = parser.iterate(json_str);
+
+    return flatten_expected(
+        Reader::Direct::simdjson_root_value(doc.get_value())
+            .transform([&](const Reader::Direct::SimdValue& val) {
+              return deserialize(val);
+            }));
+  }
+
+  template <typename Fn>
+  auto nloh_direct(const nlohmann::json& json, Fn deserialize) {
+    return flatten_expected(
+        Reader::Direct::nlohmann_root_value(json).transform(
+            [&](const Reader::Direct::NlohValue& val) {
+              return deserialize(val);
+            }));
+  }
+
+  constexpr auto des_struct = [](const auto& val) {
+    return test::deserialize_BasicStruct(val);
+  };
+
+} // namespace
+
+TEST(DIRECT_READER, concepts) {
+  using namespace Reader::Direct;
+  static_assert(Value<SimdValue> && Array<SimdArray> && Object<SimdObject>);
+  static_assert(Value<NlohValue> && Array<NlohArray> && Object<NlohObject>);
+  static_assert(!Value<Reader::JsonValue> && !Value<Data::JsonValue>);
+  static_assert(StrFieldObject<SimdObject> && StrFieldObject<NlohObject>);
+}
+
+TEST(DIRECT_READER, struct_ok) {
+  const auto simd_bs = simd_direct(
+      R"( { "bar": "Bar", "baz": [true, false], "foo": true } )"_padded,
+      des_struct);
+  const auto nloh_bs = nloh_direct(
+      R"( { "bar": "Bar", "baz": [true, false], "foo": true } )"_json,
+      des_struct);
+
+  for (const auto* exp_bs : {&simd_bs, &nloh_bs}) {
+    EXPECT_TRUE(exp_bs->has_value());
+
+    const auto& bs = exp_bs->value();
+    EXPECT_EQ(bs.bar, "Bar");
+    EXPECT_EQ(bs.baz, std::vector<bool>({true, false}));
+    EXPECT_TRUE(bs.foo);
+  }
+}
+
+TEST(DIRECT_READER, struct_escaped_keys) {
+  // "b\u0061r" is "bar", only unescaped keys match the fields
+  const auto simd_bs = simd_direct(
+      R"( { "b\u0061r": "Bar", "baz": [true], "\u0066oo": true } )"_padded,
+      des_struct);
+  const auto nloh_bs = nloh_direct(
+      R"( { "b\u0061r": "Bar", "baz": [true], "\u0066oo": true } )"_json,
+      des_struct);
+
+  for (const auto* exp_bs : {&simd_bs, &nloh_bs}) {
+    EXPECT_TRUE(exp_bs->has_value());
+
+    const auto& bs = exp_bs->value();
+    EXPECT_EQ(bs.bar, "Bar");
+    EXPECT_EQ(bs.baz, std::vector<bool>({true}));
+    EXPECT_TRUE(bs.foo);
+  }
+}
+
+TEST(DIRECT_READER, struct_projection) {
+  // only "bar" is read, the missing "foo" isn't an error
+  constexpr std::array fields{"bar"sv};
+  const auto des_bar = [&fields](const auto& val) {
+    return test::deserialize_BasicStruct(val, fields);
+  };
+  const auto simd_bs = simd_direct(
+      R"( { "baz": [true, false, [1, 2]], "bar": "Bar" } )"_padded, des_bar);
+  const auto nloh_bs =
+      nloh_direct(R"( { "baz": [true, false], "bar": "Bar" } )"_json, des_bar);
+
+  for (const auto* exp_bs : {&simd_bs, &nloh_bs}) {
+    EXPECT_TRUE(exp_bs->has_value());
+
+    const auto& bs = exp_bs->value();
+    EXPECT_EQ(bs.bar, "Bar");
+    EXPECT_TRUE(bs.baz.empty());
+    EXPECT_FALSE(bs.foo);
+  }
+
+  constexpr std::array unknown{"qux"sv};
+  const auto exp_bs = nloh_direct(R"( { "bar": "Bar" } )"_json,
+                                  [&unknown](const auto& val) {
+                                    return test::deserialize_BasicStruct(
+                                        val, unknown);
+                                  });
+  EXPECT_FALSE(exp_bs.has_value());
+}
+
+TEST(DIRECT_READER, struct_err) {
+  {
+    const auto exp_bs =
+        simd_direct(R"( { "bar": "Bar", "foo": true } )"_padded, des_struct);
+    EXPECT_FALSE(exp_bs.has_value());
+    EXPECT_EQ(exp_bs.error().type, JsonErrorTypes::String);
+    EXPECT_EQ(exp_bs.error().message, "Missing key \"baz\" for BasicStruct"sv);
+  }
+  {
+    const auto exp_bs = nloh_direct(
+        R"( { "bar": 1, "baz": [], "foo": true } )"_json, des_struct);
+    EXPECT_FALSE(exp_bs.has_value());
+    EXPECT_EQ(exp_bs.error().type, JsonErrorTypes::WrongType);
+  }
+}
+
+TEST(DIRECT_READER, enum_and_disc) {
+  {
+    // simdjson doesn't take scalar documents as values
+    const auto exp_be = nloh_direct(R"( "Baz" )"_json, [](const auto& val) {
+      return test::deserialize_BasicEnum(val);
+    });
+    EXPECT_TRUE(exp_be.has_value());
+    EXPECT_EQ(exp_be.value(), test::BasicEnum::Baz);
+  }
+  {
+    const auto exp_bd = simd_direct(
+        R"( { "baz": "some", "Type": "String" } )"_padded,
+        [](const auto& val) {
+          return test::deserialize_BasicDisc(val);
+        });
+    EXPECT_TRUE(exp_bd.has_value());
+
+    const auto& bd = exp_bd.value();
+    EXPECT_EQ(bd.type(), test::BasicDisc::Types::String);
+    EXPECT_EQ(bd.get<test::BasicDisc::Types::String>()->baz, "some");
+  }
+  {
+    const auto exp_bd =
+        nloh_direct(R"( { "Type": "Boolean", "quuz": true } )"_json,
+                    [](const auto& val) {
+                      return test::deserialize_BasicDisc(val);
+                    });
+    EXPECT_TRUE(exp_bd.has_value());
+
+    const auto& bd = exp_bd.value();
+    EXPECT_EQ(bd.type(), test::BasicDisc::Types::Boolean);
+    EXPECT_TRUE(bd.get<test::BasicDisc::Types::Boolean>()->quuz);
+  }
+  {
+    const auto exp_bd = simd_direct(
+        R"( { "quuz": true, "Type": "Unknown" } )"_padded,
+        [](const auto& val) {
+          return test::deserialize_BasicDisc(val);
+        });
+    EXPECT_FALSE(exp_bd.has_value());
+    EXPECT_EQ(exp_bd.error().type, JsonErrorTypes::Invalid);
+  }
+  // the tag errors don't depend on the reader
+  {
+    const auto des_disc = [](const auto& val) {
+      return test::deserialize_BasicDisc(val);
+    };
+    const auto simd_missing =
+        simd_direct(R"( { "quuz": true } )"_padded, des_disc);
+    const auto nloh_missing =
+        nloh_direct(R"( { "quuz": true } )"_json, des_disc);
+    for (const auto* exp_bd : {&simd_missing, &nloh_missing}) {
+      EXPECT_FALSE(exp_bd->has_value());
+      EXPECT_EQ(exp_bd->error().type, JsonErrorTypes::String);
+      EXPECT_EQ(exp_bd->error().message,
+                "Missing key \"Type\" for BasicDisc");
+    }
+
+    const auto simd_not_str =
+        simd_direct(R"( { "Type": true } )"_padded, des_disc);
+    const auto nloh_not_str =
+        nloh_direct(R"( { "Type": true } )"_json, des_disc);
+    for (const auto* exp_bd : {&simd_not_str, &nloh_not_str}) {
+      EXPECT_FALSE(exp_bd->has_value());
+      EXPECT_EQ(exp_bd->error().type, JsonErrorTypes::Invalid);
+      EXPECT_EQ(exp_bd->error().message, "Expected string value for Type");
+    }
+  }
+}
+
+TEST(DIRECT_READER, simd_document_stream) {
+  const auto ndjson = R"({ "bar": "A", "baz": [], "foo": true }
+{ "bar": "B", "foo": false }
+{ "bar": "C", "baz": [true], "foo": false }
+)"_padded;
+
+  ondemand::parser parser;
+  std::vector<std::string> bars;
+  std::vector<std::size_t> error_offsets;
+  const auto exp = Reader::Direct::simdjson_for_each_document(
+      parser, ndjson, des_struct,
+      [&](const std::size_t offset, auto exp_bs) {
+        if (exp_bs.has_value()) {
+          bars.push_back(exp_bs.value().bar);
+        } else {
+          error_offsets.push_back(offset);
+        }
+      });
+
+  // the second document misses a key, the stream goes on
+  EXPECT_TRUE(exp.has_value());
+  EXPECT_EQ(bars, std::vector<std::string>({"A", "C"}));
+  EXPECT_EQ(error_offsets, std::vector<std::size_t>({39}));
+}
+
+TEST(DIRECT_READER, simd_parallel_array) {
+  std::string json = "[";
+  for (int i = 0; i < 100; ++i) {
+    json += std::format(R"({}{{ "bar": "{}", "baz": [], "foo": true }})",
+                        i == 0 ? "" : ", ", i);
+  }
+  json += "]";
+
+  const Reader::Direct::SimdParallelOptions options{.chunk_size = 7,
+                                                    .threads = 4};
+  {
+    const padded_string padded(json);
+    auto exp =
+        Reader::Direct::simdjson_parallel_array(padded, des_struct, options);
+    EXPECT_TRUE(exp.has_value());
+    EXPECT_EQ(exp.value().size(), 100);
+    for (int i = 0; const auto& bs : exp.value()) {
+      EXPECT_EQ(bs.bar, std::to_string(i++));
+    }
+  }
+
+  // the first error by index, like the serial path
+  for (const auto idx : {"12"sv, "93"sv}) {
+    auto broken = json;
+    const auto pos = broken.find(std::format(R"("bar": "{}")", idx));
+    broken.replace(pos, 5, R"("bax")");
+    const padded_string padded(broken);
+
+    auto par =
+        Reader::Direct::simdjson_parallel_array(padded, des_struct, options);
+    auto ser = simd_direct(padded, [](const auto& val) {
+      return Reader::Direct::json_array_for_each(val, [](const auto& item) {
+        return des_struct(item).transform([](auto&&) {});
+      });
+    });
+    EXPECT_FALSE(par.has_value());
+    EXPECT_FALSE(ser.has_value());
+    EXPECT_EQ(par.error().message, ser.error().message);
+  }
+}
+
+TEST(DIRECT_READER, primitives_and_values) {
+  {
+    const auto exp_prims = simd_direct(
+        R"( { "u8": 255, "i16": -32768, "u32": 12, "f32": 1.5 } )"_padded,
+        [](const auto& val) {
+          return test::deserialize_Primitives(val);
+        });
+    EXPECT_TRUE(exp_prims.has_value());
+    EXPECT_EQ(exp_prims.value().u8, 255);
+    EXPECT_EQ(exp_prims.value().i16, -32768);
+    EXPECT_EQ(exp_prims.value().f32, 1.5f);
+  }
+  {
+    const auto exp_prims = nloh_direct(
+        R"( { "u8": 256, "i16": 0, "u32": 0, "f32": 0.5 } )"_json,
+        [](const auto& val) {
+          return test::deserialize_Primitives(val);
+        });
+    EXPECT_FALSE(exp_prims.has_value());
+    EXPECT_EQ(exp_prims.error().message,
+              "Unsigned value 256 is greater than 255"sv);
+  }
+  {
+    const auto exp_dict = simd_direct(
+        R"( { "free": { "a": [1, -2, 0.5], "b": { "c": null } } } )"_padded,
+        [](const auto& val) {
+          return test::deserialize_Dictionary(val);
+        });
+    EXPECT_TRUE(exp_dict.has_value());
+
+    const auto& free = exp_dict.value().free;
+    EXPECT_EQ(free.size(), 2);
+    EXPECT_EQ(free.at("a").get_type(), JsonTypes::Array);
+    EXPECT_EQ(free.at("b").get_type(), JsonTypes::Object);
+  }
+}
+
+TEST(DIRECT_READER, number_arrays) {
+  constexpr auto des_numbers = [](const auto& val) {
+    return test::deserialize_NumberArrays(val);
+  };
+  {
+    const auto exp_na = simd_direct(R"( { "samples": [1, 2.5], "levels": [0.5],
+                                          "counts": [-3, 4] } )"_padded,
+                                    des_numbers);
+    EXPECT_TRUE(exp_na.has_value());
+    EXPECT_EQ(exp_na.value().samples, std::vector<double>({1.0, 2.5}));
+    EXPECT_EQ(exp_na.value().levels, std::vector<float>({0.5f}));
+    EXPECT_EQ(exp_na.value().counts, std::vector<int32_t>({-3, 4}));
+  }
+  {
+    // through the type erased reader
+    const auto json =
+        R"( { "samples": [], "levels": [1.5], "counts": [7] } )"_json;
+    const auto exp_na = flatten_expected(
+        Reader::nlohmann_root_value(json).transform(
+            [](const Reader::JsonValue& val) {
+              return test::deserialize_NumberArrays(val);
+            }));
+    EXPECT_TRUE(exp_na.has_value());
+    EXPECT_EQ(exp_na.value().levels, std::vector<float>({1.5f}));
+    EXPECT_EQ(exp_na.value().counts, std::vector<int32_t>({7}));
+  }
+  {
+    // the first error by index, the limits before the type
+    const auto json = R"( { "samples": [], "levels": [],
+                            "counts": [1, 3000000000, "x"] } )"_json;
+    const auto exp_na = nloh_direct(json, des_numbers);
+    EXPECT_FALSE(exp_na.has_value());
+    EXPECT_EQ(exp_na.error().message, "Signed value 3000000000 outside limits "
+                                      "-2147483648:2147483647"sv);
+  }
+  {
+    const auto json = R"( { "samples": [], "levels": [],
+                            "counts": [1, "x", 3000000000] } )"_padded;
+    const auto exp_na = simd_direct(json, des_numbers);
+    EXPECT_FALSE(exp_na.has_value());
+    EXPECT_EQ(exp_na.error().type, JsonErrorTypes::WrongType);
+  }
+}
+
+#endif
@@ -20,7 +20,8 @@ TEST(NLOH_READ, invalid) {
 
 TEST(NLOH_READ, non_array_object) {
   {
-    auto json_val = Reader::nlohmann_root_value(R"( true )"_json);
+    const auto json = R"( true )"_json;
+    auto json_val = Reader::nlohmann_root_value(json);
     EXPECT_TRUE(json_val.has_value());
 
     auto val = std::move(json_val.value());
@@ -30,7 +31,8 @@ TEST(NLOH_READ, non_array_object) {
     EXPECT_TRUE(exp_bool.value());
   }
   {
-    auto json_val = Reader::nlohmann_root_value(R"( false )"_json);
+    const auto json = R"( false )"_json;
+    auto json_val = Reader::nlohmann_root_value(json);
     EXPECT_TRUE(json_val.has_value());
 
     auto val = std::move(json_val.value());
@@ -40,7 +42,8 @@ TEST(NLOH_READ, non_array_object) {
     EXPECT_FALSE(exp_bool.value());
   }
   {
-    auto json_val = Reader::nlohmann_root_value(R"( null )"_json);
+    const auto json = R"( null )"_json;
+    auto json_val = Reader::nlohmann_root_value(json);
     EXPECT_TRUE(json_val.has_value());
 
     auto val = std::move(json_val.value());
@@ -50,7 +53,8 @@ TEST(NLOH_READ, non_array_object) {
     EXPECT_TRUE(exp_null.value());
   }
   {
-    auto json_val = Reader::nlohmann_root_value(R"( 123 )"_json);
+    const auto json = R"( 123 )"_json;
+    auto json_val = Reader::nlohmann_root_value(json);
     EXPECT_TRUE(json_val.has_value());
 
     auto val = std::move(json_val.value());
@@ -60,7 +64,8 @@ TEST(NLOH_READ, non_array_object) {
     EXPECT_EQ(exp_number.value(), 123ll);
   }
   {
-    auto json_val = Reader::nlohmann_root_value(R"( 123 )"_json);
+    const auto json = R"( 123 )"_json;
+    auto json_val = Reader::nlohmann_root_value(json);
     EXPECT_TRUE(json_val.has_value());
 
     auto val = std::move(json_val.value());
@@ -70,7 +75,8 @@ TEST(NLOH_READ, non_array_object) {
     EXPECT_EQ(exp_number.value(), 123.0);
   }
   {
-    auto json_val = Reader::nlohmann_root_value(R"( "Bob" )"_json);
+    const auto json = R"( "Bob" )"_json;
+    auto json_val = Reader::nlohmann_root_value(json);
     EXPECT_TRUE(json_val.has_value());
 
     auto val = std::move(json_val.value());
@@ -78,11 +84,19 @@ TEST(NLOH_READ, non_array_object) {
 
     EXPECT_TRUE(exp_str.has_value());
     EXPECT_EQ(exp_str.value(), "Bob");
+
+    auto exp_view = val.read_str_view();
+    EXPECT_TRUE(exp_view.has_value());
+    EXPECT_EQ(exp_view.value(), "Bob"sv);
+    // no copy, the view points inside the document
+    EXPECT_EQ(exp_view.value().data(),
+              json.get_ref<const std::string&>().data());
   }
 }
 
 TEST(NLOH_READ, empty_array) {
-  auto json_val = Reader::nlohmann_root_value(R"( [] )"_json);
+  const auto json = R"( [] )"_json;
+  auto json_val = Reader::nlohmann_root_value(json);
   EXPECT_TRUE(json_val.has_value());
 
   auto val = std::move(json_val.value());
@@ -98,7 +112,8 @@ TEST(NLOH_READ, empty_array) {
 }
 
 TEST(NLOH_READ, empty_object) {
-  auto json_val = Reader::nlohmann_root_value(R"( {} )"_json);
+  const auto json = R"( {} )"_json;
+  auto json_val = Reader::nlohmann_root_value(json);
   EXPECT_TRUE(json_val.has_value());
 
   auto val = std::move(json_val.value());
@@ -114,7 +129,8 @@ TEST(NLOH_READ, empty_object) {
 }
 
 TEST(NLOH_READ, array_of_numbers) {
-  auto json_val = Reader::nlohmann_root_value(R"( [1,2,3,4] )"_json);
+  const auto json = R"( [1,2,3,4] )"_json;
+  auto json_val = Reader::nlohmann_root_value(json);
   EXPECT_TRUE(json_val.has_value());
 
   auto val = std::move(json_val.value());
@@ -133,6 +149,34 @@ TEST(NLOH_READ, array_of_numbers) {
   EXPECT_EQ(exp, 5);
 }
 
+TEST(NLOH_READ, size_hints) {
+  const auto json = R"( {"A": [1, 2, 3], "B": {}} )"_json;
+  auto json_val = Reader::nlohmann_root_value(json);
+  EXPECT_TRUE(json_val.has_value());
+
+  auto obj = json_val.value().read_object();
+  EXPECT_TRUE(obj.has_value());
+  EXPECT_EQ(obj.value().size_hint(), 2);
+
+  for (const auto& item : obj.value().views()) {
+    EXPECT_TRUE(item.has_value());
+    const auto& [key, val] = item.value();
+    if (key == "A"sv) {
+      auto arr = val.read_array();
+      EXPECT_TRUE(arr.has_value());
+      EXPECT_EQ(arr.value().size_hint(), 3);
+
+      auto clone = arr.value().clone();
+      EXPECT_TRUE(clone.has_value());
+      EXPECT_EQ(clone.value().internal().capacity(), 3);
+    } else {
+      auto sub = val.read_object();
+      EXPECT_TRUE(sub.has_value());
+      EXPECT_EQ(sub.value().size_hint(), 0);
+    }
+  }
+}
+
 TEST(NLOH_READ, object_with_incr_arrays_of_types) {
   constexpr std::array<std::tuple<std::string_view, JsonTypes, int>, 5>
       expectations = {{
@@ -143,13 +187,14 @@ TEST(NLOH_READ, object_with_incr_arrays_of_types) {
           {"Elle"sv, JsonTypes::String, 5},
       }};
 
-  auto json_val = Reader::nlohmann_root_value(R"( {
+  const auto json = R"( {
     "Alice": [1],
     "Bob": [false, true],
     "Chuck": [{}, {}, {}],
     "Dave": [[],[],[],[]],
     "Elle": ["a", "b", "c", "d", "e"]
-  } )"_json);
+  } )"_json;
+  auto json_val = Reader::nlohmann_root_value(json);
   EXPECT_TRUE(json_val.has_value());
 
   auto val = std::move(json_val.value());
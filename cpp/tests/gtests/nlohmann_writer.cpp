@@ -127,6 +127,28 @@ TEST(NLOH_WRITE, primitive_arrays) {
   }
 }
 
+TEST(NLOH_WRITE, float_as_double) {
+  NJson jsarr = NJson::array();
+  expect_serial(jsarr, [](auto& serial) {
+    expect_ok_op(serial.write_float(0.1f));
+  });
+
+  // the double is the float's shortest text, not its widened value
+  EXPECT_EQ(jsarr[0], 0.1);
+  EXPECT_EQ(jsarr.dump(), "[0.1]");
+}
+
+TEST(NLOH_WRITE, key_token) {
+  NJson jsobj = NJson::object();
+  expect_serial(jsobj, [](auto& serial) {
+    expect_ok_op(serial.write_key_token({"a\"b"sv, R"("a\"b":)"sv}));
+    expect_ok_op(serial.write_i64(1));
+  });
+
+  EXPECT_EQ(jsobj.size(), 1);
+  EXPECT_EQ(jsobj["a\"b"], 1);
+}
+
 TEST(NLOH_WRITE, primitive_objects) {
   {
     NJson jsobj = NJson::object();
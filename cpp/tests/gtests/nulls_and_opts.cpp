@@ -38,7 +38,10 @@ namespace {
           return make_json_error(JsonErrorTypes::Invalid);
         }));
 
-    return flatten_expected(exp_enum.transform(test::deserialize_NullableEnum));
+    return flatten_expected(
+        exp_enum.transform([](const Reader::JsonValue& val) {
+          return test::deserialize_NullableEnum(val);
+        }));
   }
 
   ExpNullableStruct get_exp_null_struct(const padded_str& json_str) {
@@ -60,7 +63,9 @@ namespace {
         }));
 
     return flatten_expected(
-        exp_struct.transform(test::deserialize_NullableStruct));
+        exp_struct.transform([](const Reader::JsonValue& val) {
+          return test::deserialize_NullableStruct(val);
+        }));
   }
 
   ExpOptProps get_exp_opt_props(const padded_str& json_str) {
@@ -46,7 +46,10 @@ namespace {
           return make_json_error(JsonErrorTypes::Invalid);
         }));
 
-    return flatten_expected(exp_str.transform(test::deserialize_RootString));
+    return flatten_expected(
+        exp_str.transform([](const Reader::JsonValue& val) {
+          return test::deserialize_RootString(val);
+        }));
   }
 
 } // namespace
@@ -0,0 +1,108 @@
+#if defined(USE_SIMD) && defined(USE_SIMD_DOM)
+
+#include "generated/basic_disc.hpp"
+#include "generated/basic_enum.hpp"
+#include "generated/basic_struct.hpp"
+#include "simd_dom.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace JsonTypedefCodeGen;
+using namespace simdjson;
+using namespace std::string_view_literals;
+
+TEST(SIMD_DOM, read_again) {
+  const auto json = R"( { "A": [1, -2, 3.5], "B": "b" } )"_padded;
+
+  dom::parser parser;
+  auto json_val = Reader::simdjson_dom_root_value(parser.parse(json));
+  EXPECT_TRUE(json_val.has_value());
+
+  // unlike ondemand, the same object can be walked more than once
+  for (int i = 0; i < 2; ++i) {
+    auto exp_obj = json_val.value().read_object();
+    EXPECT_TRUE(exp_obj.has_value());
+
+    std::vector<std::string> keys;
+    auto exp = Reader::json_object_for_each(
+        exp_obj.value(),
+        [&keys](const std::string_view key, const Reader::JsonValue&) {
+          keys.emplace_back(key);
+          return ExpType<void>();
+        });
+    EXPECT_TRUE(exp.has_value());
+    EXPECT_EQ(keys, std::vector<std::string>({"A", "B"}));
+
+    auto exp_str = exp_obj.value().read_str_field("B"sv);
+    EXPECT_TRUE(exp_str.has_value());
+    EXPECT_EQ(exp_str.value(), "b"sv);
+  }
+}
+
+TEST(SIMD_DOM, number_types) {
+  const auto json = R"( [1, -2, 3.5, 18446744073709551615] )"_padded;
+
+  dom::parser parser;
+  auto exp_arr =
+      Reader::Direct::simdjson_dom_root_value(parser.parse(json))
+          .and_then([](const auto& val) { return val.read_array(); });
+  EXPECT_TRUE(exp_arr.has_value());
+
+  std::vector<NumberType> types;
+  for (auto item : exp_arr.value()) {
+    EXPECT_TRUE(item.has_value());
+    types.push_back(item.value().get_number_type());
+  }
+  EXPECT_EQ(types, std::vector<NumberType>({NumberType::I64, NumberType::I64,
+                                            NumberType::Double,
+                                            NumberType::U64}));
+}
+
+TEST(SIMD_DOM, direct_deserialize) {
+  using namespace Reader::Direct;
+  static_assert(Value<SimdDomValue> && Array<SimdDomArray> &&
+                Object<SimdDomObject> && StrFieldObject<SimdDomObject>);
+
+  dom::parser parser;
+  const auto parse = [&parser](const padded_string& json, auto deserialize) {
+    return flatten_expected(
+        simdjson_dom_root_value(parser.parse(json))
+            .transform([&](const SimdDomValue& val) {
+              return deserialize(val);
+            }));
+  };
+
+  {
+    const auto exp_bs =
+        parse(R"( { "bar": "Bar", "baz": [true], "foo": true } )"_padded,
+              [](const auto& val) {
+                return test::deserialize_BasicStruct(val);
+              });
+    EXPECT_TRUE(exp_bs.has_value());
+    EXPECT_EQ(exp_bs.value().bar, "Bar");
+    EXPECT_EQ(exp_bs.value().baz, std::vector<bool>({true}));
+  }
+  {
+    // scalar documents are values in the DOM
+    const auto exp_be = parse(R"( "Baz" )"_padded, [](const auto& val) {
+      return test::deserialize_BasicEnum(val);
+    });
+    EXPECT_TRUE(exp_be.has_value());
+    EXPECT_EQ(exp_be.value(), test::BasicEnum::Baz);
+  }
+  {
+    // the tag is looked up by key, the object is then read from the start
+    const auto exp_bd =
+        parse(R"( { "quuz": true, "Type": "Boolean" } )"_padded,
+              [](const auto& val) {
+                return test::deserialize_BasicDisc(val);
+              });
+    EXPECT_TRUE(exp_bd.has_value());
+    EXPECT_EQ(exp_bd.value().type(), test::BasicDisc::Types::Boolean);
+    EXPECT_TRUE(exp_bd.value().get<test::BasicDisc::Types::Boolean>()->quuz);
+  }
+}
+
+#endif
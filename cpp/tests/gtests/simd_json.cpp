@@ -3,45 +3,97 @@
 #include "simd.hpp"
 
 #include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
 
 using namespace JsonTypedefCodeGen;
 using namespace simdjson;
 using namespace std::string_view_literals;
 
-// TODO: a class to hold the parser and document alive for the whole test
-
-static ExpType<Reader::JsonValue>
-from_padded_string(simdjson::padded_string& json) {
-  ondemand::parser parser;
-  auto doc = parser.iterate(json);
-  return Reader::simdjson_root_value(doc.get_value());
-}
-
 TEST(SIMD_JSON, ignore_empty) {
-  auto json_str = R"( )"_padded;
+  Reader::SimdDocument document(R"( )"_padded);
 
-  auto json_val = from_padded_string(json_str);
+  auto json_val = document.root();
   EXPECT_FALSE(json_val.has_value());
   EXPECT_EQ(json_val.error().type, JsonErrorTypes::Internal);
 }
 
 TEST(SIMD_JSON, ignore_non_array_object) {
   {
-    auto json_str = R"( true )"_padded;
-    auto json_val = from_padded_string(json_str);
+    Reader::SimdDocument document(R"( true )"_padded);
+    auto json_val = document.root();
     EXPECT_FALSE(json_val.has_value());
     EXPECT_EQ(json_val.error().type, JsonErrorTypes::WrongType);
   }
   {
-    auto json_str = R"( 123 )"_padded;
-
-    auto json_val = from_padded_string(json_str);
+    Reader::SimdDocument document(R"( 123 )"_padded);
+    auto json_val = document.root();
     EXPECT_FALSE(json_val.has_value());
     EXPECT_EQ(json_val.error().type, JsonErrorTypes::WrongType);
   }
 }
 
+TEST(SIMD_JSON, owning_documents) {
+  // the parsers are given back to the pool, and reused
+  for (int64_t i = 0; i < 8; ++i) {
+    Reader::SimdDocument document(std::format("[{}, {}]", i, i + 1));
+
+    auto json_val = document.root();
+    EXPECT_TRUE(json_val.has_value());
+
+    int64_t sum = 0;
+    auto exp = Reader::json_array_for_each(
+        json_val.value(), [&sum](const Reader::JsonValue& item) {
+          return item.read_i64().transform([&sum](auto v) { sum += v; });
+        });
+    EXPECT_TRUE(exp.has_value());
+    EXPECT_EQ(sum, 2 * i + 1);
+  }
+
+  Reader::SimdDocument document(R"( { "A": "a" } )"sv);
+  auto direct_val = document.direct_root();
+  EXPECT_TRUE(direct_val.has_value());
+  EXPECT_EQ(direct_val.value().get_type(), JsonTypes::Object);
+}
+
+TEST(SIMD_JSON, mapped_file) {
+  const auto path =
+      std::filesystem::temp_directory_path() / "jtd_codegen_mapped.json";
+  // a full page, the padding lands in the anonymous pages
+  for (const std::size_t size : {std::size_t{40}, std::size_t{4096}}) {
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      const auto json = std::format("[1,{}2]", std::string(size - 5, ' '));
+      out << json;
+    }
+
+    auto exp_doc = Reader::SimdDocument::from_file(path);
+    EXPECT_TRUE(exp_doc.has_value());
+
+    auto json_val = exp_doc.value()->root();
+    EXPECT_TRUE(json_val.has_value());
+
+    int64_t sum = 0;
+    auto exp = Reader::json_array_for_each(
+        json_val.value(), [&sum](const Reader::JsonValue& item) {
+          return item.read_i64().transform([&sum](auto v) { sum += v; });
+        });
+    EXPECT_TRUE(exp.has_value());
+    EXPECT_EQ(sum, 3);
+  }
+  std::filesystem::remove(path);
+
+  auto missing = Reader::SimdDocument::from_file(path);
+  EXPECT_FALSE(missing.has_value());
+  EXPECT_EQ(missing.error().type, JsonErrorTypes::InOut);
+}
+
 TEST(SIMD_JSON, empty_array) {
   auto json_str = R"( [] )"_padded;
 
@@ -136,6 +188,48 @@ TEST(SIMD_JSON, array_of_numbers_with_error) {
   EXPECT_EQ(exp, 5);
 }
 
+TEST(SIMD_JSON, number_types) {
+  auto json_str = R"( [1, -2, 3.5, 18446744073709551615] )"_padded;
+
+  ondemand::parser parser;
+  auto doc = parser.iterate(json_str);
+  auto exp_arr =
+      Reader::Direct::simdjson_root_value(doc.get_value())
+          .and_then([](const auto& val) { return val.read_array(); });
+  EXPECT_TRUE(exp_arr.has_value());
+
+  // the reads after the classification use the decoded number
+  int idx = 0;
+  for (auto item : exp_arr.value()) {
+    EXPECT_TRUE(item.has_value());
+    const auto& val = item.value();
+    switch (idx++) {
+    case 0:
+      EXPECT_EQ(val.get_number_type(), NumberType::U64);
+      EXPECT_EQ(val.read_u64(), 1);
+      EXPECT_EQ(val.read_i64(), 1);
+      EXPECT_EQ(val.read_double(), 1.0);
+      break;
+    case 1:
+      EXPECT_EQ(val.get_number_type(), NumberType::I64);
+      EXPECT_EQ(val.read_i64(), -2);
+      EXPECT_FALSE(val.read_u64().has_value());
+      break;
+    case 2:
+      EXPECT_EQ(val.get_number_type(), NumberType::Double);
+      EXPECT_EQ(val.read_double(), 3.5);
+      EXPECT_FALSE(val.read_i64().has_value());
+      break;
+    default:
+      EXPECT_EQ(val.get_number_type(), NumberType::U64);
+      EXPECT_EQ(val.read_u64(), 18446744073709551615ull);
+      EXPECT_FALSE(val.read_i64().has_value());
+      break;
+    }
+  }
+  EXPECT_EQ(idx, 4);
+}
+
 TEST(SIMD_JSON, object_key_val) {
   auto json_str = R"( { "A": 1, "B": 2, "C": 3 } )"_padded;
   constexpr std::array<std::pair<std::string_view, uint64_t>, 3> expectations =
@@ -168,6 +262,153 @@ TEST(SIMD_JSON, object_key_val) {
   EXPECT_EQ(count, 3);
 }
 
+TEST(SIMD_JSON, string_views) {
+  auto json_str = R"( ["Alice", "B\u00f6b", 3] )"_padded;
+
+  ondemand::parser parser;
+  auto doc = parser.iterate(json_str);
+  auto json_val = Reader::simdjson_root_value(doc.get_value());
+  EXPECT_TRUE(json_val.has_value());
+
+  std::vector<std::string_view> views;
+  auto exp = Reader::json_array_for_each(
+      json_val.value(), [&views](const Reader::JsonValue& item) {
+        return item.read_str_view().transform(
+            [&views](const auto sv) { views.push_back(sv); });
+      });
+
+  // the views are still valid after their values are gone
+  EXPECT_FALSE(exp.has_value());
+  EXPECT_EQ(exp.error().type, JsonErrorTypes::WrongType);
+  EXPECT_EQ(views.size(), 2);
+  EXPECT_EQ(views[0], "Alice"sv);
+  EXPECT_EQ(views[1], "B\xc3\xb6" "b"sv);
+}
+
+TEST(SIMD_JSON, object_key_views) {
+  auto json_str = R"( { "A": 1, "Bb": 2, "Ccc": 3 } )"_padded;
+
+  ondemand::parser parser;
+  auto doc = parser.iterate(json_str);
+  auto json_val = Reader::simdjson_root_value(doc.get_value());
+  EXPECT_TRUE(json_val.has_value());
+
+  auto obj = json_val.value().read_object();
+  EXPECT_TRUE(obj.has_value());
+
+  // keys point inside the padded string
+  std::vector<std::string_view> keys;
+  for (auto kvpair : obj.value().views()) {
+    EXPECT_TRUE(kvpair.has_value());
+    const auto& [key, val] = kvpair.value();
+    EXPECT_EQ(val.read_u64(), key.size());
+    keys.push_back(key);
+  }
+
+  EXPECT_EQ(keys.size(), 3);
+  for (const auto key : keys) {
+    EXPECT_GE(key.data(), json_str.data());
+    EXPECT_LT(key.data(), json_str.data() + json_str.size());
+  }
+  EXPECT_EQ(keys[2], "Ccc"sv);
+}
+
+TEST(SIMD_JSON, object_escaped_keys) {
+  auto json_str = R"( { "A": 1, "B\u00f6": 2, "C\"c": 3 } )"_padded;
+
+  ondemand::parser parser;
+  auto doc = parser.iterate(json_str);
+  auto json_val = Reader::simdjson_root_value(doc.get_value());
+  EXPECT_TRUE(json_val.has_value());
+
+  auto obj = json_val.value().read_object();
+  EXPECT_TRUE(obj.has_value());
+
+  std::vector<std::string> keys;
+  for (auto kvpair : obj.value().views()) {
+    EXPECT_TRUE(kvpair.has_value());
+    keys.emplace_back(kvpair.value().first);
+  }
+  EXPECT_EQ(keys, std::vector<std::string>({"A", "B\xc3\xb6", "C\"c"}));
+}
+
+TEST(SIMD_JSON, object_str_field) {
+  auto json_str = R"( { "A": 1, "Bb": "two", "Ccc": 3 } )"_padded;
+
+  ondemand::parser parser;
+  auto doc = parser.iterate(json_str);
+  auto json_val = Reader::simdjson_root_value(doc.get_value());
+  EXPECT_TRUE(json_val.has_value());
+
+  auto obj = json_val.value().read_object();
+  EXPECT_TRUE(obj.has_value());
+
+  EXPECT_EQ(obj.value().read_str_field("Bb"sv), "two"sv);
+  const auto not_str = obj.value().read_str_field("A"sv);
+  EXPECT_FALSE(not_str.has_value());
+  EXPECT_EQ(not_str.error().type, JsonErrorTypes::WrongType);
+  EXPECT_EQ(obj.value().read_str_field("Dddd"sv), std::nullopt);
+
+  // the object is iterated from the start afterwards
+  std::vector<std::string_view> keys;
+  for (auto kvpair : obj.value().views()) {
+    EXPECT_TRUE(kvpair.has_value());
+    keys.push_back(kvpair.value().first);
+  }
+  EXPECT_EQ(keys, std::vector<std::string_view>({"A"sv, "Bb"sv, "Ccc"sv}));
+}
+
+TEST(SIMD_JSON, size_hints) {
+  auto json_str = R"( { "A": [1, 2, 3], "B": {} } )"_padded;
+
+  // not counted unless asked for
+  for (const bool count_items : {false, true}) {
+    ondemand::parser parser;
+    auto doc = parser.iterate(json_str);
+    auto json_val =
+        Reader::Direct::simdjson_root_value(doc.get_value(), count_items);
+    EXPECT_TRUE(json_val.has_value());
+
+    auto obj = json_val.value().read_object();
+    EXPECT_TRUE(obj.has_value());
+    EXPECT_EQ(obj.value().size_hint(), count_items ? 2 : 0);
+
+    std::vector<std::size_t> hints;
+    for (auto item : obj.value()) {
+      EXPECT_TRUE(item.has_value());
+      const auto& [key, val] = item.value();
+      if (key == "A"sv) {
+        auto arr = val.read_array();
+        EXPECT_TRUE(arr.has_value());
+        hints.push_back(arr.value().size_hint());
+      } else {
+        auto sub = val.read_object();
+        EXPECT_TRUE(sub.has_value());
+        hints.push_back(sub.value().size_hint());
+      }
+    }
+    EXPECT_EQ(hints, count_items ? std::vector<std::size_t>({3, 0})
+                                 : std::vector<std::size_t>({0, 0}));
+  }
+}
+
+TEST(SIMD_JSON, for_each_move_only_callback) {
+  auto json_str = R"( [1,2,3,4] )"_padded;
+
+  ondemand::parser parser;
+  auto doc = parser.iterate(json_str);
+  auto json_val = Reader::simdjson_root_value(doc.get_value());
+  EXPECT_TRUE(json_val.has_value());
+
+  // std::function can't hold it, only the templated overload takes it
+  auto sum = std::make_unique<int64_t>(0);
+  auto exp = Reader::json_array_for_each(
+      json_val.value(), [sum = std::move(sum)](const Reader::JsonValue& item) {
+        return item.read_i64().transform([&sum](auto v) { *sum += v; });
+      });
+  EXPECT_TRUE(exp.has_value());
+}
+
 TEST(SIMD_JSON, object_with_incr_arrays_of_types) {
   auto json_str = R"( {
     "Alice": [1],
@@ -224,4 +465,59 @@ TEST(SIMD_JSON, object_with_incr_arrays_of_types) {
   EXPECT_EQ(count, 5);
 }
 
+// count the allocations reaching the heap
+class CountingResource : public std::pmr::memory_resource {
+public:
+  int count = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++count;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* ptr, std::size_t bytes, std::size_t align) override {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(SIMD_JSON, session_pool) {
+  std::string json = "[";
+  for (int i = 0; i < 1000; ++i) {
+    json += (i == 0 ? "{ \"A\": [" : ",{ \"A\": [") + std::to_string(i) + "] }";
+  }
+  json += "]";
+  auto json_str = padded_string(json);
+
+  CountingResource counter;
+  {
+    Reader::Session session(&counter);
+
+    ondemand::parser parser;
+    auto doc = parser.iterate(json_str);
+    auto json_val = Reader::simdjson_root_value(doc.get_value(), session);
+    EXPECT_TRUE(json_val.has_value());
+
+    int64_t sum = 0;
+    auto exp = Reader::json_array_for_each(
+        json_val.value(), [&sum](const Reader::JsonValue& item) {
+          return Reader::json_object_for_each(
+              item, [&sum](const auto, const Reader::JsonValue& val) {
+                return Reader::json_array_for_each(
+                    val, [&sum](const Reader::JsonValue& num) {
+                      return num.read_i64().transform(
+                          [&sum](auto v) { sum += v; });
+                    });
+              });
+        });
+    EXPECT_TRUE(exp.has_value());
+    EXPECT_EQ(sum, 499500);
+  }
+
+  // pimpl objects are recycled, so the memory doesn't grow with the nodes
+  EXPECT_LE(counter.count, 4);
+}
+
 #endif // USE_SIMD
@@ -4,38 +4,61 @@
     using Disc = $FULL_NAME$;
     static constexpr std::string_view discName = "$DISC_NAME$"sv;
 
-    static ExpType<int> get_disc_index(const Data::JsonObject& object) {
+    template<typename JObject>
+    static ExpType<int> get_disc_index(const JObject& object) {
       auto exp_disc = get_disc_value(object, "$TAG_KEY$"sv, discName);
 
       return flatten_expected(
           exp_disc.transform([](const std::string_view disc) {
-            return get_value_index(disc, Common<Disc>::entries, discName);
+            return get_value_index(Common<Disc>::find(disc), disc, discName);
           }));
     }
 
-    static ExpType<Disc> to_disc(const Data::JsonObject& object, int idx) {
+    template<typename JObject>
+    static ExpType<Disc> to_disc(const JObject& object, int idx) {
       constexpr auto cast = [](auto v) { return Disc(v); };
       switch (idx) {
         default:$CLAUSES$
       }
     }
 
+    template<typename JObject>
+    static ExpType<Disc> from_object(const JObject& object) {
+      return flatten_expected(
+          get_disc_index(object).transform([&](int idx) {
+            return to_disc(object, idx);
+          }));
+    }
+
     static ExpType<Disc> deserialize(const Data::JsonValue &value) {
       auto exp_obj = optional_to_exp_type(value.read_object(), JsonErrorTypes::Invalid, "not an object"sv);
 
       return flatten_expected(
-          exp_obj.transform(
-            [](const Data::JsonObject object) -> ExpType<Disc> {
-              return flatten_expected(
-                  get_disc_index(object).transform([&](int idx) {
-                    return to_disc(object, idx);
-                  }));
-            }));
+          exp_obj.transform([](const Data::JsonObject object) {
+            return from_object(object);
+          }));
     }
 
+    // the tag is read on the reader's object, the variant is then
+    // deserialized from it without a copy
     static ExpType<Disc> deserialize(const Reader::JsonValue &value) {
-      return flatten_expected(value.clone().transform([](Data::JsonValue val) {
-        return Json<Disc>::deserialize(val);
-      }));
+      return flatten_expected(
+          value.read_object().transform([](const Reader::JsonObject& object) {
+            return from_object(object);
+          }));
+    }
+
+    template<Reader::Direct::Value JValue>
+    static ExpType<Disc> deserialize(const JValue &value) {
+      if constexpr (Reader::Direct::StrFieldObject<typename JValue::Object>) {
+        return flatten_expected(
+            value.read_object().transform([](const auto& object) {
+              return from_object(object);
+            }));
+      } else {
+        return flatten_expected(Reader::Direct::clone(value).transform([](Data::JsonValue val) {
+          return Json<Disc>::deserialize(val);
+        }));
+      }
     }
   };
@@ -5,7 +5,7 @@
 
     template<typename JValue>
     static ExpType<Enum> deserialize(const JValue &value) {
-      return get_enum_index(value, Common<Enum>::entries, "$ENUM_NAME$"sv)
+      return get_enum_index(value, Common<Enum>::find, "$ENUM_NAME$"sv)
         .transform([](int idx) { return (Enum)idx; });
     }
   };
@@ -1,6 +1,7 @@
 
   template<> struct Serialize<$FULL_NAME$> {
-    static ExpType<void> serialize(Writer::Serializer& serializer, const $FULL_NAME$ value) {
+    template<Writer::Direct::Serializer JWriter>
+    static ExpType<void> serialize(JWriter& serializer, const $FULL_NAME$ value) {
       using Enum = $FULL_NAME$;
       return serializer.write_str(Common<Enum>::entries[int(value)]);
     }
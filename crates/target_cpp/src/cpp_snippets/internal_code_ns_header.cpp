@@ -6,6 +6,6 @@ using namespace std::string_view_literals;
     return exp;                                                                \
   }
 
-#define SHORT_KEY_VAL(key, val)                                                \
-  SHORT_EXP(serializer.write_key((key)));                                      \
+#define SHORT_KEY_VAL(key, token, val)                                         \
+  SHORT_EXP(serializer.write_key_token(Writer::KeyToken{(key), (token)}));     \
   SHORT_EXP(Serialize<decltype(val)>::serialize(serializer, (val)));
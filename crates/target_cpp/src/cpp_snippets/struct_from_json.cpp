@@ -7,19 +7,41 @@
 
     template<typename JValue>
     static ExpType<Struct> deserialize(const JValue& value) {
+      return deserialize_fields(value, AllFields{});
+    }
+
+    // the fields outside of "keys" are skipped, left default constructed
+    template<typename JValue>
+    static ExpType<Struct> deserialize(const JValue& value, const FieldProjection keys) {
+      using Mask = std::remove_const_t<decltype(mandatory)>;
+      return flatten_expected(
+        project_fields<Mask>(keys, Common<Struct>::find, st_name)
+        .transform([&](const Mask& wanted) {
+          return deserialize_fields(value, wanted);
+        }));
+    }
+
+    template<typename JValue, typename Wanted>
+    static ExpType<Struct> deserialize_fields(const JValue& value, const Wanted& wanted) {
       $VISITED$
       Struct result;
+      int last_idx = -1;
 
       auto feach = json_object_for_each(
         value,
         [&](const auto key, const auto &val) {
           return flatten_expected(
-            get_value_index(key, Common<Struct>::entries, st_name)
+            get_value_index(
+              find_next_index(key, last_idx, Common<Struct>::entries, Common<Struct>::find),
+              key, st_name)
             .transform([&](const int idx) -> ExpType<void> {
-              if (visited[idx]) {
+              if (visited.test(idx)) {
                 return Errors::duplicated_key(key);
               }
-              visited[idx] = true;
+              visited.set(idx);
+              if (!wanted.test(idx)) {
+                return ExpType<void>();
+              }
 
               switch (idx) {
                 default:$CLAUSES$
@@ -29,7 +51,8 @@
 
       return chain_void_expected(
         feach,
-        visited_mandatory(mandatory_indices, visited, Common<Struct>::entries, st_name)
+        check_mandatory(visited, wanted_mandatory(mandatory, wanted),
+                        Common<Struct>::entries, st_name)
       ).transform([&result]() { return std::move(result); });
     }
   };
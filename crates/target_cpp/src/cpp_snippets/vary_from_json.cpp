@@ -5,20 +5,24 @@
     static constexpr std::string_view vary_name = "$VARY_NAME$"sv;
     $MANDATORY$
 
-    static ExpType<Vary> deserialize(const Data::JsonObject& value) {
+    template<typename JObject>
+    static ExpType<Vary> deserialize(const JObject& value) {
       $VISITED$
       Vary result;
+      int last_idx = -1;
 
       auto feach = json_object_for_each(
         value,
-        [&](const std::string_view key, const auto val) {
+        [&](const std::string_view key, const auto &val) {
           return flatten_expected(
-            get_value_index(key, Common<Vary>::entries, vary_name)
+            get_value_index(
+              find_next_index(key, last_idx, Common<Vary>::entries, Common<Vary>::find),
+              key, vary_name)
             .transform([&](int idx) -> ExpType<void> {
-                if (visited[idx]) {
+                if (visited.test(idx)) {
                   return Errors::duplicated_key(key);
                 }
-                visited[idx] = true;
+                visited.set(idx);
 
                 switch (idx) {
                   default:// discriminator
@@ -29,7 +33,7 @@
 
       return chain_void_expected(
         feach,
-        visited_mandatory(mandatory_indices, visited, Common<Vary>::entries, vary_name)
+        check_mandatory(visited, mandatory, Common<Vary>::entries, vary_name)
       ).transform([&result]() { return std::move(result); });
     }
   };
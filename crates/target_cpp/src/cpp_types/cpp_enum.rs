@@ -58,7 +58,7 @@ enum class {}: int {{
                 } else {
                     ", "
                 };
-                format!("{}\"{}\"sv", prefix, m.json_value)
+                format!("{}{}", prefix, cpp_string_literal(&m.json_value))
             })
             .collect::<String>();
         create_entry_array(&items, self.members.len())
@@ -67,14 +67,22 @@ enum class {}: int {{
     pub fn get_common_internal_code(&self, cpp_props: &CppProps) -> String {
         let fullname = cpp_props.get_namespaced_name(&self.name);
         let entries = self.create_entry_array();
+        let keys = self
+            .members
+            .iter()
+            .map(|m| m.json_value.as_str())
+            .collect::<Vec<_>>();
+        let find = create_find_function(&keys);
 
         format!(
             r#"
   template<> struct Common<{}> {{
     {}
+
+    {}
   }};
 "#,
-            fullname, entries
+            fullname, entries, find
         )
     }
 
@@ -37,7 +37,15 @@ impl CppStruct {
     }
 
     pub fn prototype(&self, cpp_props: &CppProps) -> String {
-        prototype_name(&self.name, cpp_props)
+        let mut res = prototype_name(&self.name, cpp_props);
+        res.push_str(&prototype_projection(&self.name, cpp_props));
+        res
+    }
+
+    pub fn define(&self, cpp_props: &CppProps) -> String {
+        let mut res = get_complete_definition(&self.name, cpp_props);
+        res.push_str(&get_projection_definition(&self.name, cpp_props));
+        res
     }
 
     fn create_entry_array(&self) -> String {
@@ -53,7 +61,7 @@ impl CppStruct {
                 } else {
                     ", "
                 };
-                format!("{}\"{}\"sv", prefix, f.json_name)
+                format!("{}{}", prefix, cpp_string_literal(&f.json_name))
             })
             .collect::<String>();
         create_entry_array(&items, self.fields.len())
@@ -62,14 +70,22 @@ impl CppStruct {
     pub fn get_common_internal_code(&self, cpp_props: &CppProps) -> String {
         let fullname = cpp_props.get_namespaced_name(&self.name);
         let entries = self.create_entry_array();
+        let keys = self
+            .fields
+            .iter()
+            .map(|f| f.json_name.as_str())
+            .collect::<Vec<_>>();
+        let find = create_find_function(&keys);
 
         format!(
             r#"
   template<> struct Common<{}> {{
     {}
+
+    {}
   }};
 "#,
-            fullname, entries
+            fullname, entries, find
         )
     }
 
@@ -92,13 +108,16 @@ impl CppStruct {
             .map(|f| {
                 if f.optional {
                     format!(
-                        "      if (value.{}) {{ SHORT_KEY_VAL(\"{}\"sv, value.{}); }}\n",
-                        f.name, f.json_name, f.name
+                        "      if (value.{}) {{ SHORT_KEY_VAL({}, value.{}); }}\n",
+                        f.name,
+                        create_key_args(&f.json_name),
+                        f.name
                     )
                 } else {
                     format!(
-                        "      SHORT_KEY_VAL(\"{}\"sv, value.{});\n",
-                        f.json_name, f.name
+                        "      SHORT_KEY_VAL({}, value.{});\n",
+                        create_key_args(&f.json_name),
+                        f.name
                     )
                 }
             })
@@ -104,7 +104,7 @@ impl CppDiscriminator {
                 } else {
                     ", "
                 };
-                format!("{}\"{}\"sv", prefix, v.tag_value)
+                format!("{}{}", prefix, cpp_string_literal(&v.tag_value))
             })
             .collect::<String>();
         create_entry_array(&items, self.variants.len())
@@ -128,14 +128,22 @@ impl CppDiscriminator {
     pub fn get_common_internal_code(&self, cpp_props: &CppProps) -> String {
         let fullname = cpp_props.get_namespaced_name(&self.name);
         let entries = self.create_entry_array();
+        let keys = self
+            .variants
+            .iter()
+            .map(|v| v.tag_value.as_str())
+            .collect::<Vec<_>>();
+        let find = create_find_function(&keys);
 
         format!(
             r#"
   template<> struct Common<{}> {{
     {}
+
+    {}
   }};
 "#,
-            fullname, entries
+            fullname, entries, find
         )
     }
 
@@ -176,7 +184,7 @@ impl CppDiscriminator {
         let clauses = self.get_ser_clauses(cpp_props);
         INTERNAL_CODE_DISC_SER
             .replace("$FULL_NAME$", &fullname)
-            .replace("$TAG_KEY$", &self.tag_json_name)
+            .replace("$TAG_KEY_ARGS$", &create_key_args(&self.tag_json_name))
             .replace("$CLAUSES$", &clauses)
     }
 }
@@ -240,12 +248,12 @@ impl CppDiscriminatorVariant {
                 } else {
                     ", "
                 };
-                format!("{}\"{}\"sv", prefix, f.json_name)
+                format!("{}{}", prefix, cpp_string_literal(&f.json_name))
             })
             .collect::<String>();
 
         create_entry_array(
-            &format!("\"{}\"sv{}", self.tag_json_name, items),
+            &format!("{}{}", cpp_string_literal(&self.tag_json_name), items),
             self.fields.len() + 1,
         )
     }
@@ -253,14 +261,20 @@ impl CppDiscriminatorVariant {
     pub fn get_common_internal_code(&self, cpp_props: &CppProps) -> String {
         let fullname = cpp_props.get_namespaced_name(&self.name);
         let entries = self.create_entry_array();
+        let keys = std::iter::once(self.tag_json_name.as_str())
+            .chain(self.fields.iter().map(|f| f.json_name.as_str()))
+            .collect::<Vec<_>>();
+        let find = create_find_function(&keys);
 
         format!(
             r#"
   template<> struct Common<{}> {{
     {}
+
+    {}
   }};
 "#,
-            fullname, entries
+            fullname, entries, find
         )
     }
 
@@ -285,15 +299,18 @@ impl CppDiscriminatorVariant {
                     format!(
                         r#"    if (value.{}) {{
       auto& tmp = *value.{};
-      SHORT_KEY_VAL("{}"sv, tmp);
+      SHORT_KEY_VAL({}, tmp);
     }}
 "#,
-                        f.name, f.name, f.json_name
+                        f.name,
+                        f.name,
+                        create_key_args(&f.json_name)
                     )
                 } else {
                     format!(
-                        "    SHORT_KEY_VAL(\"{}\"sv, value.{});\n",
-                        f.json_name, f.name
+                        "    SHORT_KEY_VAL({}, value.{});\n",
+                        create_key_args(&f.json_name),
+                        f.name
                     )
                 }
             })
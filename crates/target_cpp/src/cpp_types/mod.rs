@@ -66,9 +66,7 @@ impl CppTypes {
     pub fn define(&self, cpp_state: &CppState, cpp_props: &CppProps) -> Option<String> {
         match &self {
             CppTypes::Enum(_enum) => Some(get_complete_definition(&_enum.get_name(), cpp_props)),
-            CppTypes::Struct(_struct) => {
-                Some(get_complete_definition(&_struct.get_name(), cpp_props))
-            }
+            CppTypes::Struct(_struct) => Some(_struct.define(cpp_props)),
             CppTypes::Discriminator(disc) => {
                 Some(get_complete_definition(&disc.get_name(), cpp_props))
             }
@@ -1,3 +1,5 @@
+use std::collections::BTreeMap;
+
 use jtd_codegen::target::Field;
 
 use crate::cpp_snippets::ENTRIES_ARRAY;
@@ -11,6 +13,82 @@ pub fn create_entry_array(entries: &str, size: usize) -> String {
         .replace("$ENTRIES$", entries)
 }
 
+fn create_key_comparisons(keys: &[(usize, &str)], indent: &str) -> String {
+    keys.iter()
+        .map(|(idx, key)| {
+            format!(
+                "\n{}if (key == {}) {{ return {}; }}",
+                indent,
+                cpp_string_literal(key),
+                idx
+            )
+        })
+        .collect::<String>()
+}
+
+fn create_first_char_switch(keys: &[(usize, &str)]) -> String {
+    let mut by_char: BTreeMap<u8, Vec<(usize, &str)>> = BTreeMap::new();
+    for (idx, key) in keys {
+        by_char
+            .entry(key.as_bytes()[0])
+            .or_default()
+            .push((*idx, key));
+    }
+
+    let cases = by_char
+        .iter()
+        .map(|(c, same_char)| {
+            let label = if c.is_ascii_alphanumeric() || *c == b'_' {
+                format!("'{}'", *c as char)
+            } else {
+                format!("0x{:02x}", c)
+            };
+            format!(
+                "\n        case {}:{}\n          break;",
+                label,
+                create_key_comparisons(same_char, "          ")
+            )
+        })
+        .collect::<String>();
+
+    format!(
+        "\n        switch (static_cast<unsigned char>(key[0])) {{{}\n        default:\n          break;\n        }}",
+        cases
+    )
+}
+
+// lookup of a key in "entries", by its size then its first character,
+// instead of comparing all of them. Returns -1 if it's not found
+pub fn create_find_function(entries: &[&str]) -> String {
+    let mut by_size: BTreeMap<usize, Vec<(usize, &str)>> = BTreeMap::new();
+    for (idx, key) in entries.iter().enumerate() {
+        by_size.entry(key.len()).or_default().push((idx, key));
+    }
+
+    let cases = by_size
+        .iter()
+        .map(|(size, same_size)| {
+            let body = if same_size.len() < 3 {
+                create_key_comparisons(same_size, "        ")
+            } else {
+                create_first_char_switch(same_size)
+            };
+            format!("\n      case {}:{}\n        break;", size, body)
+        })
+        .collect::<String>();
+
+    format!(
+        r#"static constexpr int find(const std::string_view key) {{
+      switch (key.size()) {{{}
+      default:
+        break;
+      }}
+      return -1;
+    }}"#,
+        cases
+    )
+}
+
 fn get_mandatory_indices(fields: &Vec<Field>, idx_offset: usize) -> Vec<usize> {
     fields
         .iter()
@@ -22,6 +100,7 @@ fn get_mandatory_indices(fields: &Vec<Field>, idx_offset: usize) -> Vec<usize> {
         .collect()
 }
 
+// "idx_offset" entries come before the fields, like a variant's tag
 pub fn create_mandatory_indices(fields: &Vec<Field>, idx_offset: usize) -> String {
     let midx = get_mandatory_indices(fields, idx_offset);
 
@@ -35,9 +114,11 @@ pub fn create_mandatory_indices(fields: &Vec<Field>, idx_offset: usize) -> Strin
         .collect::<String>();
 
     format!(
-        r#"static constexpr std::array<int, {}> mandatory_indices = {{ {} }};"#,
+        r#"static constexpr std::array<int, {}> mandatory_indices = {{ {} }};
+    static constexpr FieldMask<{}> mandatory{{ mandatory_indices }};"#,
         midx.len(),
-        str_midx
+        str_midx,
+        fields.len() + idx_offset
     )
 }
 
@@ -74,12 +155,88 @@ fn deserialize_name(name: &str) -> String {
     format!("deserialize_{}", name)
 }
 
-fn des_function_name(name: &str, full_ns: bool) -> String {
+fn des_function_name(name: &str, value_type: &str, full_ns: bool) -> String {
+    format!(
+        "ExpType<{}> {}(const {}Reader::{}& value)",
+        name,
+        deserialize_name(name),
+        if full_ns { "JsonTypedefCodeGen::" } else { "" },
+        value_type
+    )
+}
+
+fn des_projection_name(name: &str, value_type: &str, full_ns: bool) -> String {
+    let ns = if full_ns { "JsonTypedefCodeGen::" } else { "" };
     format!(
-        "ExpType<{}> {}(const {}Reader::JsonValue& value)",
+        "ExpType<{}> {}(const {}Reader::{}& value, const {}FieldProjection fields)",
         name,
         deserialize_name(name),
-        if full_ns { "JsonTypedefCodeGen::" } else { "" }
+        ns,
+        value_type,
+        ns
+    )
+}
+
+// one overload per compile-time reader, only if its library is enabled
+fn for_each_direct_reader<F>(cpp_props: &CppProps, f: F) -> String
+where
+    F: Fn(&str) -> String,
+{
+    cpp_props
+        .get_direct_readers()
+        .iter()
+        .map(|direct| {
+            format!(
+                "\n#ifdef {}{}\n#endif",
+                direct.define(),
+                f(direct.value_type())
+            )
+        })
+        .collect::<String>()
+}
+
+// C++ string_view literal of "text", non-ASCII bytes are kept as UTF-8
+pub fn cpp_string_literal(text: &str) -> String {
+    let mut res = String::from("\"");
+    for c in text.chars() {
+        match c {
+            '"' => res.push_str("\\\""),
+            '\\' => res.push_str("\\\\"),
+            c if (c as u32) < 0x20 || c == '\x7f' => res.push_str(&format!("\\{:03o}", c as u32)),
+            c => res.push(c),
+        }
+    }
+    res.push_str("\"sv");
+    res
+}
+
+// the key as written by the serializers: "\"key\":", same escapes
+fn json_key_token(key: &str) -> String {
+    let mut res = String::from("\"");
+    for c in key.chars() {
+        match c {
+            '"' => res.push_str("\\\""),
+            '\\' => res.push_str("\\\\"),
+            '\u{8}' => res.push_str("\\b"),
+            '\u{c}' => res.push_str("\\f"),
+            '\n' => res.push_str("\\n"),
+            '\r' => res.push_str("\\r"),
+            '\t' => res.push_str("\\t"),
+            c if (c as u32) < 0x20 => res.push_str(&format!("\\u{:04x}", c as u32)),
+            c => res.push(c),
+        }
+    }
+    res.push_str("\":");
+    res
+}
+
+// key and pre-escaped token of SHORT_KEY_VAL, so that a field's key is
+// written in one copy
+pub fn create_key_args(json_name: &str) -> String {
+    format!(
+        "{}, {}",
+        cpp_string_literal(json_name),
+        cpp_string_literal(&json_key_token(json_name))
     )
 }
 
@@ -87,30 +244,85 @@ fn serialize_name(name: &str) -> String {
     format!("serialize_{}", name)
 }
 
-fn ser_function_name(name: &str, full_ns: bool) -> String {
+fn ser_function_name(name: &str, serializer_type: &str, full_ns: bool) -> String {
     format!(
-        "ExpType<void> {}({}Writer::Serializer& serializer, const {}& value)",
+        "ExpType<void> {}({}{}& serializer, const {}& value)",
         serialize_name(name),
         if full_ns { "JsonTypedefCodeGen::" } else { "" },
+        serializer_type,
         name
     )
 }
 
+// one overload per compile-time writer, plus the type-erased Serializer
+fn for_each_serializer<F>(cpp_props: &CppProps, f: F) -> String
+where
+    F: Fn(&str) -> String,
+{
+    let mut res = f("Writer::Serializer");
+    for direct in cpp_props.get_direct_writers() {
+        res.push_str(&f(direct.serializer_type()));
+    }
+    res
+}
+
 pub fn prototype_name(name: &str, cpp_props: &CppProps) -> String {
     let output = cpp_props.get_output();
     let mut res = String::new();
     if output.deserialize() {
-        res.push_str(&format!(
-            "\nJsonTypedefCodeGen::{};",
-            des_function_name(name, true)
-        ));
+        let proto = |value_type: &str| {
+            format!(
+                "\nJsonTypedefCodeGen::{};",
+                des_function_name(name, value_type, true)
+            )
+        };
+        res.push_str(&proto("JsonValue"));
+        res.push_str(&for_each_direct_reader(cpp_props, proto));
     }
     if output.serialize() {
-        res.push_str(&format!(
+        res.push_str(&for_each_serializer(cpp_props, |serializer_type| {
+            format!(
+                "\nJsonTypedefCodeGen::{};",
+                ser_function_name(name, serializer_type, true)
+            )
+        }));
+    }
+    res
+}
+
+// structs can also be read partially, given the JSON keys of their fields
+pub fn prototype_projection(name: &str, cpp_props: &CppProps) -> String {
+    if !cpp_props.get_output().deserialize() {
+        return String::new();
+    }
+    let proto = |value_type: &str| {
+        format!(
             "\nJsonTypedefCodeGen::{};",
-            ser_function_name(name, true)
-        ));
+            des_projection_name(name, value_type, true)
+        )
+    };
+    let mut res = proto("JsonValue");
+    res.push_str(&for_each_direct_reader(cpp_props, proto));
+    res
+}
+
+pub fn get_projection_definition(name: &str, cpp_props: &CppProps) -> String {
+    if !cpp_props.get_output().deserialize() {
+        return String::new();
     }
+    let define = |value_type: &str| {
+        format!(
+            r#"
+{} {{
+  return JsonTypedefCodeGen::Deserialize::Json<{}>::deserialize(value, fields);
+}}
+"#,
+            des_projection_name(name, value_type, true),
+            name
+        )
+    };
+    let mut res = define("JsonValue");
+    res.push_str(&for_each_direct_reader(cpp_props, define));
     res
 }
 
@@ -118,37 +330,62 @@ pub fn get_complete_definition(name: &str, cpp_props: &CppProps) -> String {
     let output = cpp_props.get_output();
     let mut res = String::new();
     if output.deserialize() {
-        res.push_str(&format!(
-            r#"
+        let define = |value_type: &str| {
+            format!(
+                r#"
 {} {{
   return JsonTypedefCodeGen::Deserialize::Json<{}>::deserialize(value);
 }}
 "#,
-            des_function_name(name, true),
-            name
-        ));
+                des_function_name(name, value_type, true),
+                name
+            )
+        };
+        res.push_str(&define("JsonValue"));
+        res.push_str(&for_each_direct_reader(cpp_props, define));
     }
     if output.serialize() {
-        res.push_str(&format!(
-            r#"
+        res.push_str(&for_each_serializer(cpp_props, |serializer_type| {
+            format!(
+                r#"
 {} {{
   return JsonTypedefCodeGen::Serialize::Serialize<{}>::serialize(serializer, value);
 }}
 "#,
-            ser_function_name(name, true),
-            name
-        ));
+                ser_function_name(name, serializer_type, true),
+                name
+            )
+        }));
     }
     res
 }
 
 pub fn create_visited_array(sz: usize) -> String {
-    let falses = match sz {
-        0 | 1 => String::new(),
-        _ => (0..(sz - 1)).map(|_i| ", false").collect::<String>(),
-    };
-    format!(
-        r#"std::array<bool, {}> visited = {{ false{} }};"#,
-        sz, falses
-    )
+    format!(r#"FieldMask<{}> visited;"#, sz)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn creates_key_args() {
+        assert_eq!(create_key_args("bar"), r#""bar"sv, "\"bar\":"sv"#);
+        assert_eq!(
+            create_key_args("a\"b\\c"),
+            r#""a\"b\\c"sv, "\"a\\\"b\\\\c\":"sv"#
+        );
+        assert_eq!(
+            create_key_args("t\tu\u{1}"),
+            r#""t\011u\001"sv, "\"t\\tu\\u0001\":"sv"#
+        );
+        assert_eq!(create_key_args("é"), "\"é\"sv, \"\\\"é\\\":\"sv");
+    }
+
+    #[test]
+    fn escapes_keys_in_find() {
+        let find = create_find_function(&["a\"b", "c\\d"]);
+        assert!(find.contains(r#"if (key == "a\"b"sv) { return 0; }"#));
+        assert!(find.contains(r#"if (key == "c\\d"sv) { return 1; }"#));
+    }
 }
@@ -89,6 +89,70 @@ impl Output {
     }
 }
 
+// compile-time readers, see "direct_reader.hpp"
+#[derive(Deserialize, Clone, Copy, PartialEq, Debug)]
+pub enum DirectReader {
+    #[serde(rename = "simdjson")]
+    SimdJson,
+    #[serde(rename = "simdjson_dom")]
+    SimdJsonDom,
+    #[serde(rename = "nlohmann")]
+    Nlohmann,
+    #[serde(rename = "napi")]
+    Napi,
+}
+
+impl DirectReader {
+    pub fn value_type(&self) -> &'static str {
+        match self {
+            DirectReader::SimdJson => "Direct::SimdValue",
+            DirectReader::SimdJsonDom => "Direct::SimdDomValue",
+            DirectReader::Nlohmann => "Direct::NlohValue",
+            DirectReader::Napi => "Direct::NapiValue",
+        }
+    }
+
+    // macro enabling the library in the wrappers
+    pub fn define(&self) -> &'static str {
+        match self {
+            DirectReader::SimdJson => "USE_SIMD",
+            DirectReader::SimdJsonDom => "USE_SIMD_DOM",
+            DirectReader::Nlohmann => "USE_IN_NLOH",
+            DirectReader::Napi => "USE_IN_NAPI",
+        }
+    }
+
+    fn header_file(&self) -> &'static str {
+        match self {
+            DirectReader::SimdJson => "simd.hpp",
+            DirectReader::SimdJsonDom => "simd_dom.hpp",
+            DirectReader::Nlohmann => "nlohmann.hpp",
+            DirectReader::Napi => "napi.hpp",
+        }
+    }
+}
+
+// compile-time writers, see "direct_writer.hpp"
+#[derive(Deserialize, Clone, Copy, PartialEq, Debug)]
+pub enum DirectWriter {
+    #[serde(rename = "stream")]
+    Stream,
+}
+
+impl DirectWriter {
+    pub fn serializer_type(&self) -> &'static str {
+        match self {
+            DirectWriter::Stream => "Writer::StreamSerializer",
+        }
+    }
+
+    fn header_file(&self) -> &'static str {
+        match self {
+            DirectWriter::Stream => "stream_serializer.hpp",
+        }
+    }
+}
+
 #[derive(Default, Deserialize)]
 pub struct CppProps {
     #[serde(rename = "guard")]
@@ -106,6 +170,12 @@ pub struct CppProps {
 
     #[serde(default)]
     output: Output,
+
+    #[serde(rename = "direct_readers", default)]
+    direct_readers: Vec<DirectReader>,
+
+    #[serde(rename = "direct_writers", default)]
+    direct_writers: Vec<DirectWriter>,
     // include found header files needed?
     // implement destructors
     // provide copy (with constructor/assignment) or "clone" function
@@ -118,6 +188,22 @@ impl CppProps {
         self.output
     }
 
+    pub fn get_direct_readers(&self) -> &[DirectReader] {
+        if self.output.deserialize() {
+            &self.direct_readers
+        } else {
+            &[]
+        }
+    }
+
+    pub fn get_direct_writers(&self) -> &[DirectWriter] {
+        if self.output.serialize() {
+            &self.direct_writers
+        } else {
+            &[]
+        }
+    }
+
     pub fn get_guard(&self) -> String {
         match &self.guard {
             Some(head) => head.get_guard(),
@@ -157,9 +243,15 @@ impl CppProps {
         let mut res = self.include_data.get_header_file("json_data.hpp");
         if self.output.deserialize() {
             res.push_str(&self.include_reader.get_header_file("json_reader.hpp"));
+            for direct in &self.direct_readers {
+                res.push_str(&self.include_reader.get_header_file(direct.header_file()));
+            }
         }
         if self.output.serialize() {
             res.push_str(&self.include_writer.get_header_file("json_writer.hpp"));
+            for direct in &self.direct_writers {
+                res.push_str(&self.include_writer.get_header_file(direct.header_file()));
+            }
         }
         res
     }
@@ -192,7 +284,7 @@ impl CppProps {
 // ------
 #[cfg(test)]
 mod tests {
-    use crate::props::{CppProps,Guard, JsonCodeGenInclude};
+    use crate::props::{CppProps, DirectReader, Guard, JsonCodeGenInclude};
 
     #[test]
     fn default() {
@@ -273,4 +365,53 @@ mod tests {
             "#include \"where/it/is/test.h\"\n"
         );
     }
+
+    #[test]
+    fn uses_direct_readers() {
+        let json = r#"{"direct_readers":["simdjson","nlohmann"],"include_reader":"local"}"#;
+
+        let props: CppProps = serde_json::from_str(json).unwrap();
+        assert_eq!(
+            props.get_direct_readers(),
+            &[DirectReader::SimdJson, DirectReader::Nlohmann]
+        );
+        assert_eq!(
+            props.get_codegen_includes(),
+            "#include <json_data.hpp>\n#include \"json_reader.hpp\"\n#include \"simd.hpp\"\n#include \"nlohmann.hpp\"\n#include <json_writer.hpp>\n"
+        );
+
+        let json = r#"{"direct_readers":["simdjson_dom"],"include_reader":"local"}"#;
+        let props: CppProps = serde_json::from_str(json).unwrap();
+        assert_eq!(props.get_direct_readers(), &[DirectReader::SimdJsonDom]);
+        assert_eq!(
+            props.get_direct_readers()[0].value_type(),
+            "Direct::SimdDomValue"
+        );
+
+        let json = r#"{"direct_readers":["napi"],"output":"serialize"}"#;
+        let props: CppProps = serde_json::from_str(json).unwrap();
+        assert_eq!(props.get_direct_readers().is_empty(), true);
+        assert_eq!(CppProps::default().get_direct_readers().is_empty(), true);
+    }
+
+    #[test]
+    fn uses_direct_writers() {
+        let json = r#"{"direct_writers":["stream"],"include_writer":"local"}"#;
+
+        let props: CppProps = serde_json::from_str(json).unwrap();
+        assert_eq!(props.get_direct_writers(), &[DirectWriter::Stream]);
+        assert_eq!(
+            props.get_direct_writers()[0].serializer_type(),
+            "Writer::StreamSerializer"
+        );
+        assert_eq!(
+            props.get_codegen_includes(),
+            "#include <json_data.hpp>\n#include <json_reader.hpp>\n#include \"json_writer.hpp\"\n#include \"stream_serializer.hpp\"\n"
+        );
+
+        let json = r#"{"direct_writers":["stream"],"output":"deserialize"}"#;
+        let props: CppProps = serde_json::from_str(json).unwrap();
+        assert_eq!(props.get_direct_writers().is_empty(), true);
+        assert_eq!(CppProps::default().get_direct_writers().is_empty(), true);
+    }
 }